@@ -47,7 +47,10 @@ public class AssetVault : ModuleRules
                 "CoreUObject",
                 "Engine",
                 "Slate",            // Использование Slate для UI
-                "SlateCore", "Blutility" // Основные классы для работы с Slate
+                "SlateCore", "Blutility", // Основные классы для работы с Slate
+                "DeveloperSettings",
+                "DirectoryWatcher",
+                "EditorSubsystem"
             }
         );
 
@@ -1,20 +1,23 @@
 ﻿#include "AssetVault.h"
+#include "AssetVaultDependencyCache.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogAssetVault);
+
 class FAssetVaultModule : public IModuleInterface
 {
 public:
 	
 	virtual void StartupModule() override
 	{
-		
-		UE_LOG(LogTemp, Warning, TEXT("AssetVault Plugin Started"));
+		FAssetVaultDependencyCache::Get().BindToAssetRegistry();
+		UE_LOG(LogAssetVault, Log, TEXT("AssetVault Plugin Started"));
 	}
 	
 	virtual void ShutdownModule() override
 	{
-		
-		UE_LOG(LogTemp, Warning, TEXT("AssetVault Plugin Shut Down"));
+		FAssetVaultDependencyCache::Get().UnbindFromAssetRegistry();
+		UE_LOG(LogAssetVault, Log, TEXT("AssetVault Plugin Shut Down"));
 	}
 };
 
@@ -0,0 +1,556 @@
+#include "AssetVaultArchive.h"
+#include "AssetVault.h"
+#include "AssetVaultCompression.h"
+#include "AssetVaultCopyEngine.h"
+#include "AssetVaultFileCopy.h"
+#include "AssetVaultSettings.h"
+
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "Hash/Blake3.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Tasks/Task.h"
+
+#include <atomic>
+
+namespace AssetVaultArchive
+{
+	constexpr uint32 Magic = 0x4B505641; // "AVPK"
+	constexpr uint32 Version = 1;
+
+	// Magic, version, TOC offset, TOC size and TOC CRC, padded.
+	constexpr int64 HeaderSize = 64;
+
+	struct FHeader
+	{
+		uint32 Magic = 0;
+		uint32 Version = 0;
+		int64 TocOffset = 0;
+		int64 TocSize = 0;
+		uint32 TocCrc = 0;
+
+		friend FArchive& operator<<(FArchive& Ar, FHeader& Header)
+		{
+			return Ar << Header.Magic << Header.Version << Header.TocOffset << Header.TocSize << Header.TocCrc;
+		}
+	};
+
+	// Entries are joined to the import target folder, anything but a plain relative path could leave it.
+	static bool IsNormalizedRelativePath(const FString& Path)
+	{
+		if (Path.IsEmpty() || !FPaths::IsRelative(Path) || Path.Contains(TEXT("\\")) || Path.Contains(TEXT(":")))
+		{
+			return false;
+		}
+
+		TArray<FString> Parts;
+		Path.ParseIntoArray(Parts, TEXT("/"), false);
+		for (const FString& Part : Parts)
+		{
+			if (Part.IsEmpty() || Part == TEXT(".") || Part == TEXT(".."))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static void SerializeToc(FArchive& Ar, FName& CompressionFormat, TArray<FAssetVaultArchiveEntry>& Entries, TArray<FAssetVaultArchiveChunk>& Chunks, FString& MetadataJson)
+	{
+		FString FormatName = CompressionFormat.ToString();
+		Ar << FormatName;
+		if (Ar.IsLoading())
+		{
+			CompressionFormat = FName(*FormatName);
+		}
+
+		int32 NumEntries = Entries.Num();
+		Ar << NumEntries;
+		if (Ar.IsLoading())
+		{
+			if (NumEntries < 0)
+			{
+				Ar.SetError();
+				return;
+			}
+			Entries.SetNum(NumEntries);
+		}
+		for (FAssetVaultArchiveEntry& Entry : Entries)
+		{
+			Ar << Entry.RelativePath << Entry.Size << Entry.SourceTimestamp << Entry.Hash << Entry.FirstChunk << Entry.NumChunks;
+		}
+
+		int32 NumChunks = Chunks.Num();
+		Ar << NumChunks;
+		if (Ar.IsLoading())
+		{
+			if (NumChunks < 0)
+			{
+				Ar.SetError();
+				return;
+			}
+			Chunks.SetNum(NumChunks);
+		}
+		for (FAssetVaultArchiveChunk& Chunk : Chunks)
+		{
+			Ar << Chunk.Offset << Chunk.CompressedSize << Chunk.Size;
+		}
+
+		Ar << MetadataJson;
+	}
+
+	// Chunks that are read, compressed and written together. While one window is compressed
+	// on the task workers, the next one is read from disk.
+	constexpr int32 WindowChunks = 8;
+
+	struct FChunkWindow
+	{
+		TArray<uint8> Raw;
+		TArray<TArray<uint8>> Compressed;
+		TArray<bool> IsCompressed;
+		int64 NumBytes = 0;
+		int32 NumChunks = 0;
+
+		int64 GetChunkSize(int32 ChunkIndex) const
+		{
+			return FMath::Min<int64>(FAssetVaultArchive::ChunkSize, NumBytes - static_cast<int64>(ChunkIndex) * FAssetVaultArchive::ChunkSize);
+		}
+	};
+
+	static bool WritePadding(IFileHandle& Handle, int64 From, int64 To)
+	{
+		static const uint8 Zeros[FAssetVaultArchive::Alignment] = {};
+		return From >= To || Handle.Write(Zeros, To - From);
+	}
+}
+
+const TCHAR* FAssetVaultArchive::FileName = TEXT("AssetVault.avpak");
+
+FString FAssetVaultArchive::GetPath(const FString& ExportFolder)
+{
+	return FPaths::Combine(ExportFolder, FileName);
+}
+
+bool FAssetVaultArchive::Exists(const FString& ExportFolder)
+{
+	return FPlatformFileManager::Get().GetPlatformFile().FileExists(*GetPath(ExportFolder));
+}
+
+FAssetVaultArchiveWriter::FAssetVaultArchiveWriter(const FString& InExportFolder, EAssetVaultCompressionCodec InCodec, int32 InCompressionLevel)
+	: ExportFolder(InExportFolder)
+	, ArchivePath(FAssetVaultArchive::GetPath(InExportFolder))
+	, Codec(InCodec)
+	, CompressionLevel(InCompressionLevel)
+	, CompressionFormat(FAssetVaultCompression::GetFormatName(InCodec))
+{
+}
+
+FAssetVaultArchiveWriter::~FAssetVaultArchiveWriter()
+{
+	if (Handle)
+	{
+		Abort();
+	}
+}
+
+bool FAssetVaultArchiveWriter::Open()
+{
+	TempPath = ArchivePath + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+	Handle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*TempPath));
+	if (!Handle)
+	{
+		UE_LOG(LogAssetVault, Error, TEXT("Cannot create archive: %s"), *TempPath);
+		return false;
+	}
+
+	// Placeholder, the header is written last once the TOC location is known.
+	TArray<uint8> Placeholder;
+	Placeholder.SetNumZeroed(AssetVaultArchive::HeaderSize);
+	WriteOffset = AssetVaultArchive::HeaderSize;
+	return Handle->Write(Placeholder.GetData(), Placeholder.Num());
+}
+
+void FAssetVaultArchiveWriter::Abort()
+{
+	Handle.Reset();
+	FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*TempPath);
+}
+
+void FAssetVaultArchiveWriter::CompressWindow(AssetVaultArchive::FChunkWindow& Window) const
+{
+	Window.Compressed.SetNum(Window.NumChunks);
+	Window.IsCompressed.SetNumZeroed(Window.NumChunks);
+
+	if (CompressionFormat.IsNone())
+	{
+		return;
+	}
+
+	ParallelFor(Window.NumChunks, [this, &Window](int32 ChunkIndex)
+	{
+		const uint8* ChunkData = Window.Raw.GetData() + static_cast<int64>(ChunkIndex) * FAssetVaultArchive::ChunkSize;
+		Window.IsCompressed[ChunkIndex] = FAssetVaultCompression::Compress(Codec, CompressionLevel, ChunkData, Window.GetChunkSize(ChunkIndex), Window.Compressed[ChunkIndex]);
+	}, Window.NumChunks > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+}
+
+bool FAssetVaultArchiveWriter::AppendWindow(const AssetVaultArchive::FChunkWindow& Window, TArray<FAssetVaultArchiveChunk>& OutChunks)
+{
+	// One lock per window keeps the chunks of a window contiguous and in file order.
+	FScopeLock ScopeLock(&Lock);
+	if (!Handle || bWriteFailed)
+	{
+		return false;
+	}
+
+	for (int32 ChunkIndex = 0; ChunkIndex < Window.NumChunks; ++ChunkIndex)
+	{
+		const int64 Size = Window.GetChunkSize(ChunkIndex);
+		const bool bCompressed = Window.IsCompressed[ChunkIndex];
+		const uint8* Payload = bCompressed
+			? Window.Compressed[ChunkIndex].GetData()
+			: Window.Raw.GetData() + static_cast<int64>(ChunkIndex) * FAssetVaultArchive::ChunkSize;
+		const int64 PayloadSize = bCompressed ? Window.Compressed[ChunkIndex].Num() : Size;
+
+		const int64 Offset = Align(WriteOffset, FAssetVaultArchive::Alignment);
+		if (!AssetVaultArchive::WritePadding(*Handle, WriteOffset, Offset) || !Handle->Write(Payload, PayloadSize))
+		{
+			bWriteFailed = true;
+			return false;
+		}
+		WriteOffset = Offset + PayloadSize;
+
+		FAssetVaultArchiveChunk& Chunk = OutChunks.AddDefaulted_GetRef();
+		Chunk.Offset = Offset;
+		Chunk.CompressedSize = static_cast<uint32>(PayloadSize);
+		Chunk.Size = static_cast<uint32>(Size);
+	}
+	return true;
+}
+
+EAssetVaultCopyStatus FAssetVaultArchiveWriter::AddFile(const FString& SourceFile, const FString& TargetFile, const FFileStatData& SourceStat, FString& OutHash)
+{
+	FAssetVaultArchiveEntry Entry;
+	Entry.RelativePath = TargetFile;
+	if (!FPaths::MakePathRelativeTo(Entry.RelativePath, *(ExportFolder / TEXT(""))))
+	{
+		return EAssetVaultCopyStatus::Failed;
+	}
+	Entry.Size = SourceStat.FileSize;
+	Entry.SourceTimestamp = SourceStat.ModificationTime;
+
+	TUniquePtr<IFileHandle> Reader(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*SourceFile));
+	if (!Reader)
+	{
+		return EAssetVaultCopyStatus::Failed;
+	}
+
+	const int64 WindowBytes = FMath::Min<int64>(Entry.Size, AssetVaultArchive::WindowChunks * FAssetVaultArchive::ChunkSize);
+
+	AssetVaultArchive::FChunkWindow Windows[2];
+	Windows[0].Raw.SetNumUninitialized(WindowBytes);
+	if (Entry.Size > WindowBytes)
+	{
+		Windows[1].Raw.SetNumUninitialized(WindowBytes);
+	}
+
+	FBlake3 Hasher;
+	int64 Remaining = Entry.Size;
+
+	// Reading and hashing stay sequential, so the hash covers the file in order.
+	auto ReadWindow = [&Reader, &Hasher, &Remaining, WindowBytes](AssetVaultArchive::FChunkWindow& Window)
+	{
+		Window.NumBytes = FMath::Min(Remaining, WindowBytes);
+		Window.NumChunks = static_cast<int32>(FMath::DivideAndRoundUp<int64>(Window.NumBytes, FAssetVaultArchive::ChunkSize));
+		if (Window.NumBytes == 0)
+		{
+			return true;
+		}
+		if (!Reader->Read(Window.Raw.GetData(), Window.NumBytes))
+		{
+			return false;
+		}
+		Hasher.Update(Window.Raw.GetData(), Window.NumBytes);
+		Remaining -= Window.NumBytes;
+		return true;
+	};
+
+	TArray<FAssetVaultArchiveChunk> FileChunks;
+	AssetVaultArchive::FChunkWindow* Current = &Windows[0];
+	AssetVaultArchive::FChunkWindow* Next = &Windows[1];
+
+	if (!ReadWindow(*Current))
+	{
+		return EAssetVaultCopyStatus::Failed;
+	}
+
+	while (Current->NumChunks > 0)
+	{
+		bool bReadNext = true;
+		if (Remaining > 0)
+		{
+			UE::Tasks::TTask<void> CompressTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Current]()
+			{
+				CompressWindow(*Current);
+			});
+			bReadNext = ReadWindow(*Next);
+			CompressTask.Wait();
+		}
+		else
+		{
+			CompressWindow(*Current);
+			Next->NumBytes = 0;
+			Next->NumChunks = 0;
+		}
+
+		if (!bReadNext || !AppendWindow(*Current, FileChunks))
+		{
+			return EAssetVaultCopyStatus::Failed;
+		}
+		Swap(Current, Next);
+	}
+
+	const FBlake3Hash Hash = Hasher.Finalize();
+	OutHash = BytesToHex(Hash.GetBytes(), sizeof(FBlake3Hash::ByteArray)).ToLower();
+	Entry.Hash = OutHash;
+
+	FScopeLock ScopeLock(&Lock);
+	Entry.FirstChunk = Chunks.Num();
+	Entry.NumChunks = FileChunks.Num();
+	Chunks.Append(FileChunks);
+	Entries.Add(MoveTemp(Entry));
+	return EAssetVaultCopyStatus::Copied;
+}
+
+bool FAssetVaultArchiveWriter::Finalize(const FString& MetadataJson)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!Handle || bWriteFailed)
+	{
+		Abort();
+		return false;
+	}
+
+	// Workers finish in any order, sort so identical exports produce identical tables.
+	Entries.Sort([](const FAssetVaultArchiveEntry& A, const FAssetVaultArchiveEntry& B) { return A.RelativePath < B.RelativePath; });
+
+	TArray<uint8> Toc;
+	FMemoryWriter TocWriter(Toc);
+	FString Metadata = MetadataJson;
+	AssetVaultArchive::SerializeToc(TocWriter, CompressionFormat, Entries, Chunks, Metadata);
+
+	AssetVaultArchive::FHeader Header;
+	Header.Magic = AssetVaultArchive::Magic;
+	Header.Version = AssetVaultArchive::Version;
+	Header.TocOffset = Align(WriteOffset, FAssetVaultArchive::Alignment);
+	Header.TocSize = Toc.Num();
+	Header.TocCrc = FCrc::MemCrc32(Toc.GetData(), Toc.Num());
+
+	TArray<uint8> HeaderBytes;
+	FMemoryWriter HeaderWriter(HeaderBytes);
+	HeaderWriter << Header;
+	HeaderBytes.SetNumZeroed(AssetVaultArchive::HeaderSize);
+
+	const bool bWritten = AssetVaultArchive::WritePadding(*Handle, WriteOffset, Header.TocOffset)
+		&& Handle->Write(Toc.GetData(), Toc.Num())
+		&& Handle->Seek(0)
+		&& Handle->Write(HeaderBytes.GetData(), HeaderBytes.Num())
+		&& Handle->Flush();
+	Handle.Reset();
+
+	if (!bWritten || !IFileManager::Get().Move(*ArchivePath, *TempPath, true))
+	{
+		UE_LOG(LogAssetVault, Error, TEXT("Failed to write archive: %s"), *ArchivePath);
+		FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*TempPath);
+		return false;
+	}
+
+	UE_LOG(LogAssetVault, Log, TEXT("Wrote archive %s: %d files, %d chunks, %lld bytes"),
+		*ArchivePath, Entries.Num(), Chunks.Num(), Header.TocOffset + Header.TocSize);
+	return true;
+}
+
+FAssetVaultArchiveReader::FAssetVaultArchiveReader() = default;
+
+FAssetVaultArchiveReader::~FAssetVaultArchiveReader()
+{
+	// The region has to go before the handle it was mapped from.
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+bool FAssetVaultArchiveReader::Open(const FString& InArchivePath)
+{
+	ArchivePath = InArchivePath;
+
+	MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*ArchivePath));
+	if (!MappedFile)
+	{
+		UE_LOG(LogAssetVault, Error, TEXT("Cannot map archive: %s"), *ArchivePath);
+		return false;
+	}
+
+	DataSize = MappedFile->GetFileSize();
+	if (DataSize < AssetVaultArchive::HeaderSize)
+	{
+		UE_LOG(LogAssetVault, Error, TEXT("Archive is truncated: %s"), *ArchivePath);
+		return false;
+	}
+
+	MappedRegion.Reset(MappedFile->MapRegion(0, DataSize));
+	if (!MappedRegion)
+	{
+		UE_LOG(LogAssetVault, Error, TEXT("Cannot map archive: %s"), *ArchivePath);
+		return false;
+	}
+	Data = MappedRegion->GetMappedPtr();
+
+	AssetVaultArchive::FHeader Header;
+	FMemoryReaderView HeaderReader(MakeArrayView(Data, static_cast<int32>(AssetVaultArchive::HeaderSize)));
+	HeaderReader << Header;
+
+	if (Header.Magic != AssetVaultArchive::Magic || Header.Version != AssetVaultArchive::Version
+		|| Header.TocOffset < AssetVaultArchive::HeaderSize || Header.TocSize < 0 || Header.TocSize > MAX_int32
+		|| Header.TocOffset + Header.TocSize > DataSize
+		|| FCrc::MemCrc32(Data + Header.TocOffset, static_cast<int32>(Header.TocSize)) != Header.TocCrc)
+	{
+		UE_LOG(LogAssetVault, Error, TEXT("Archive header or table of contents is invalid: %s"), *ArchivePath);
+		return false;
+	}
+
+	FMemoryReaderView TocReader(MakeArrayView(Data + Header.TocOffset, static_cast<int32>(Header.TocSize)));
+	AssetVaultArchive::SerializeToc(TocReader, CompressionFormat, Entries, Chunks, MetadataJson);
+	if (TocReader.IsError())
+	{
+		UE_LOG(LogAssetVault, Error, TEXT("Archive table of contents is corrupt: %s"), *ArchivePath);
+		return false;
+	}
+
+	EntryIndices.Reserve(Entries.Num());
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		const FAssetVaultArchiveEntry& Entry = Entries[Index];
+		if (Entry.FirstChunk < 0 || Entry.NumChunks < 0 || Entry.FirstChunk + Entry.NumChunks > Chunks.Num())
+		{
+			UE_LOG(LogAssetVault, Error, TEXT("Archive entry %s points outside the chunk table: %s"), *Entry.RelativePath, *ArchivePath);
+			return false;
+		}
+		if (!AssetVaultArchive::IsNormalizedRelativePath(Entry.RelativePath))
+		{
+			UE_LOG(LogAssetVault, Error, TEXT("Archive entry %s is not a relative path inside the export: %s"), *Entry.RelativePath, *ArchivePath);
+			return false;
+		}
+		EntryIndices.Add(Entry.RelativePath, Index);
+	}
+
+	return true;
+}
+
+int32 FAssetVaultArchiveReader::FindEntry(const FString& RelativePath) const
+{
+	const int32* Index = EntryIndices.Find(RelativePath);
+	return Index ? *Index : INDEX_NONE;
+}
+
+bool FAssetVaultArchiveReader::ExtractEntry(int32 EntryIndex, const FString& TargetFile) const
+{
+	if (!Entries.IsValidIndex(EntryIndex))
+	{
+		return false;
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FAssetVaultArchiveEntry& Entry = Entries[EntryIndex];
+
+	for (int32 ChunkIndex = Entry.FirstChunk; ChunkIndex < Entry.FirstChunk + Entry.NumChunks; ++ChunkIndex)
+	{
+		if (Chunks[ChunkIndex].Offset + Chunks[ChunkIndex].CompressedSize > static_cast<uint64>(DataSize))
+		{
+			UE_LOG(LogAssetVault, Error, TEXT("Chunk of %s lies outside %s"), *Entry.RelativePath, *ArchivePath);
+			return false;
+		}
+	}
+
+	// Compressed chunks of a window are decoded in parallel, then every chunk is written in order.
+	// Raw chunks are written straight from the mapped pages.
+	constexpr int32 WindowChunks = AssetVaultArchive::WindowChunks * 2;
+	TArray<TArray<uint8>> Decoded;
+	Decoded.SetNum(FMath::Min(Entry.NumChunks, WindowChunks));
+
+	// The content only replaces TargetFile once its size and hash match the entry, a damaged archive
+	// never costs the file an overwriting import would have replaced.
+	const FString TempFile = FAssetVaultFileCopy::MakeTempPath(TargetFile);
+	FBlake3 Hasher;
+	int64 BytesWritten = 0;
+
+	bool bSuccess = false;
+	{
+		TUniquePtr<IFileHandle> Writer(PlatformFile.OpenWrite(*TempFile));
+		bSuccess = Writer.IsValid();
+
+		for (int32 WindowStart = 0; bSuccess && WindowStart < Entry.NumChunks; WindowStart += WindowChunks)
+		{
+			const int32 WindowNum = FMath::Min(WindowChunks, Entry.NumChunks - WindowStart);
+			const FAssetVaultArchiveChunk* WindowChunksData = &Chunks[Entry.FirstChunk + WindowStart];
+
+			std::atomic<bool> bDecodeFailed{ false };
+			ParallelFor(WindowNum, [this, WindowChunksData, &Decoded, &bDecodeFailed](int32 Index)
+			{
+				const FAssetVaultArchiveChunk& Chunk = WindowChunksData[Index];
+				if (Chunk.CompressedSize == Chunk.Size)
+				{
+					return;
+				}
+				Decoded[Index].SetNumUninitialized(Chunk.Size, EAllowShrinking::No);
+				if (!FAssetVaultCompression::Decompress(CompressionFormat, Data + Chunk.Offset, Chunk.CompressedSize, Decoded[Index].GetData(), Chunk.Size))
+				{
+					bDecodeFailed = true;
+				}
+			}, WindowNum > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+			bSuccess = !bDecodeFailed;
+			for (int32 Index = 0; bSuccess && Index < WindowNum; ++Index)
+			{
+				const FAssetVaultArchiveChunk& Chunk = WindowChunksData[Index];
+				const uint8* ChunkData = Chunk.CompressedSize == Chunk.Size ? Data + Chunk.Offset : Decoded[Index].GetData();
+				bSuccess = Writer->Write(ChunkData, Chunk.Size);
+				Hasher.Update(ChunkData, Chunk.Size);
+				BytesWritten += Chunk.Size;
+			}
+		}
+
+		bSuccess = bSuccess && Writer->Flush();
+	}
+
+	if (bSuccess && BytesWritten != Entry.Size)
+	{
+		UE_LOG(LogAssetVault, Error, TEXT("Extracted %lld of %lld bytes of %s from %s"), BytesWritten, Entry.Size, *Entry.RelativePath, *ArchivePath);
+		bSuccess = false;
+	}
+
+	if (bSuccess && BytesToHex(Hasher.Finalize().GetBytes(), sizeof(FBlake3Hash::ByteArray)).ToLower() != Entry.Hash)
+	{
+		UE_LOG(LogAssetVault, Error, TEXT("Hash mismatch extracting %s from %s"), *Entry.RelativePath, *ArchivePath);
+		bSuccess = false;
+	}
+
+	if (!bSuccess)
+	{
+		PlatformFile.DeleteFile(*TempFile);
+	}
+	else if (!FAssetVaultFileCopy::ReplaceFile(TempFile, TargetFile))
+	{
+		bSuccess = false;
+	}
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogAssetVault, Error, TEXT("Failed to extract %s from %s"), *Entry.RelativePath, *ArchivePath);
+	}
+	return bSuccess;
+}
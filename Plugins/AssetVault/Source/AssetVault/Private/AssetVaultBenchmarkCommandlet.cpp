@@ -0,0 +1,519 @@
+#include "AssetVaultBenchmarkCommandlet.h"
+#include "AssetVault.h"
+#include "AssetVaultCatalog.h"
+#include "AssetVaultMetadata.h"
+#include "FAssetPackageManager.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Dom/JsonObject.h"
+#include "Engine/ObjectLibrary.h"
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformProperties.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Thread.h"
+#include "Interfaces/IPluginManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+#include <atomic>
+
+namespace AssetVaultBenchmark
+{
+	static const TCHAR* ProjectPath = TEXT("/Game/AssetVaultBenchmark");
+	static const TCHAR* ImportSubfolder = TEXT("AssetVaultBenchmarkImport");
+
+	struct FSettings
+	{
+		int32 NumPackages = 200;
+		int32 FanOut = 3;
+		int32 MinSizeKB = 4;
+		int32 MaxSizeKB = 1024;
+		int32 NumExports = 20;
+		int32 NumVaultEntries = 1000;
+		int32 Iterations = 5;
+		int32 Seed = 1;
+		FString OutputDir;
+		FString VaultDir;
+		bool bKeepData = false;
+
+		void Parse(const TCHAR* Params)
+		{
+			FParse::Value(Params, TEXT("Packages="), NumPackages);
+			FParse::Value(Params, TEXT("FanOut="), FanOut);
+			FParse::Value(Params, TEXT("MinSizeKB="), MinSizeKB);
+			FParse::Value(Params, TEXT("MaxSizeKB="), MaxSizeKB);
+			FParse::Value(Params, TEXT("Exports="), NumExports);
+			FParse::Value(Params, TEXT("VaultEntries="), NumVaultEntries);
+			FParse::Value(Params, TEXT("Iterations="), Iterations);
+			FParse::Value(Params, TEXT("Seed="), Seed);
+			bKeepData = FParse::Param(Params, TEXT("KeepData"));
+
+			NumPackages = FMath::Max(NumPackages, 1);
+			FanOut = FMath::Max(FanOut, 0);
+			MinSizeKB = FMath::Max(MinSizeKB, 1);
+			MaxSizeKB = FMath::Max(MaxSizeKB, MinSizeKB);
+			NumExports = FMath::Clamp(NumExports, 1, NumPackages);
+			NumVaultEntries = FMath::Max(NumVaultEntries, 0);
+			Iterations = FMath::Max(Iterations, 1);
+
+			OutputDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AssetVaultBenchmark"));
+			FParse::Value(Params, TEXT("Output="), OutputDir);
+			OutputDir = FPaths::ConvertRelativePathToFull(OutputDir);
+			VaultDir = FPaths::Combine(OutputDir, TEXT("Vault"));
+		}
+	};
+
+	// Samples the resident memory of the process on its own thread while a call runs, so a peak in the
+	// middle of the call is seen even when the memory is released before it returns.
+	class FMemorySampler
+	{
+	public:
+
+		FMemorySampler()
+			: Thread(TEXT("AssetVaultBenchmarkMemory"), [this]() { Run(); })
+		{
+		}
+
+		~FMemorySampler()
+		{
+			bStop = true;
+			Thread.Join();
+		}
+
+		// Starts a new window at the current usage and returns it.
+		uint64 Restart()
+		{
+			const uint64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+			PeakUsedPhysical = UsedPhysical;
+			return UsedPhysical;
+		}
+
+		// Highest usage since the last Restart.
+		uint64 GetPeak()
+		{
+			Sample();
+			return PeakUsedPhysical;
+		}
+
+	private:
+
+		void Sample()
+		{
+			const uint64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+			uint64 Peak = PeakUsedPhysical;
+			while (UsedPhysical > Peak && !PeakUsedPhysical.compare_exchange_weak(Peak, UsedPhysical))
+			{
+			}
+		}
+
+		void Run()
+		{
+			while (!bStop)
+			{
+				Sample();
+				FPlatformProcess::Sleep(0.001f);
+			}
+		}
+
+		std::atomic<uint64> PeakUsedPhysical{ 0 };
+		std::atomic<bool> bStop{ false };
+		FThread Thread;
+	};
+
+	struct FOperation
+	{
+		FString Name;
+		TArray<double> Latencies;
+		int64 Bytes = 0;
+		// Highest usage seen during any call, and the most any call added on top of the usage it started with.
+		uint64 PeakUsedPhysical = 0;
+		uint64 PeakGrowth = 0;
+
+		template <typename FunctionType>
+		void Time(FMemorySampler& Memory, FunctionType&& Function)
+		{
+			const uint64 UsedBefore = Memory.Restart();
+			const double StartTime = FPlatformTime::Seconds();
+			Function();
+			Latencies.Add(FPlatformTime::Seconds() - StartTime);
+
+			const uint64 Peak = Memory.GetPeak();
+			PeakUsedPhysical = FMath::Max(PeakUsedPhysical, Peak);
+			PeakGrowth = FMath::Max(PeakGrowth, Peak - UsedBefore);
+		}
+
+		double GetTotalSeconds() const
+		{
+			double Total = 0.0;
+			for (const double Latency : Latencies)
+			{
+				Total += Latency;
+			}
+			return Total;
+		}
+
+		// Nearest rank on the sorted latencies, in milliseconds.
+		double GetPercentileMs(double Percentile) const
+		{
+			if (Latencies.IsEmpty())
+			{
+				return 0.0;
+			}
+			TArray<double> Sorted = Latencies;
+			Sorted.Sort();
+			const int32 Rank = FMath::Clamp(FMath::CeilToInt32(Percentile / 100.0 * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+			return Sorted[Rank] * 1000.0;
+		}
+	};
+
+	struct FExport
+	{
+		FName RootPackage;
+		FAssetExportOptions Options;
+		FString RelativeExportPath;
+	};
+
+	static void DeleteDirectory(const FString& Directory)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		if (PlatformFile.DirectoryExists(*Directory))
+		{
+			PlatformFile.DeleteDirectoryRecursively(*Directory);
+		}
+	}
+
+	// Package sizes follow a log-uniform distribution between the two bounds: mostly small files, a few large ones.
+	static int64 PickPayloadSize(const FSettings& Settings, FRandomStream& Random)
+	{
+		const double LogMin = FMath::Loge(static_cast<double>(Settings.MinSizeKB));
+		const double LogMax = FMath::Loge(static_cast<double>(Settings.MaxSizeKB));
+		return static_cast<int64>(FMath::Exp(FMath::Lerp(LogMin, LogMax, static_cast<double>(Random.GetFraction()))) * 1024.0);
+	}
+
+	// Each package holds an object library referencing FanOut earlier packages, so dependencies form a DAG,
+	// and a texture whose source data of random bytes gives the package its size.
+	static bool GenerateProject(const FSettings& Settings, FRandomStream& Random, TArray<FName>& OutPackageNames)
+	{
+		TArray<UObjectLibrary*> Libraries;
+		TArray<uint8> Payload;
+
+		for (int32 Index = 0; Index < Settings.NumPackages; ++Index)
+		{
+			const FString AssetName = FString::Printf(TEXT("Bench_%05d"), Index);
+			const FString PackageName = FString::Printf(TEXT("%s/%s"), ProjectPath, *AssetName);
+
+			UPackage* Package = CreatePackage(*PackageName);
+			UObjectLibrary* Library = NewObject<UObjectLibrary>(Package, *AssetName, RF_Public | RF_Standalone);
+			Library->ObjectBaseClass = UObject::StaticClass();
+
+			const int64 PayloadSize = PickPayloadSize(Settings, Random);
+			const int32 Width = 256;
+			const int32 Height = static_cast<int32>(FMath::Max<int64>(PayloadSize / Width, 1));
+			Payload.SetNumUninitialized(Width * Height, EAllowShrinking::No);
+			for (int32 Offset = 0; Offset + 4 <= Payload.Num(); Offset += 4)
+			{
+				const uint32 Value = Random.GetUnsignedInt();
+				FMemory::Memcpy(Payload.GetData() + Offset, &Value, sizeof(Value));
+			}
+
+			UTexture2D* Texture = NewObject<UTexture2D>(Package, *(AssetName + TEXT("_Payload")), RF_Public);
+			Texture->Source.Init(Width, Height, 1, 1, TSF_G8, Payload.GetData());
+			Library->AddObject(Texture);
+
+			const int32 NumDependencies = FMath::Min(Settings.FanOut, Index);
+			TSet<int32> Dependencies;
+			while (Dependencies.Num() < NumDependencies)
+			{
+				Dependencies.Add(Random.RandRange(0, Index - 1));
+			}
+			for (const int32 Dependency : Dependencies)
+			{
+				Library->AddObject(Libraries[Dependency]);
+			}
+
+			FSavePackageArgs SaveArgs;
+			SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+			SaveArgs.SaveFlags = SAVE_NoError;
+			const FString PackageFile = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+			if (!UPackage::SavePackage(Package, Library, *PackageFile, SaveArgs))
+			{
+				UE_LOG(LogAssetVault, Error, TEXT("Benchmark: failed to save %s"), *PackageFile);
+				return false;
+			}
+
+			Libraries.Add(Library);
+			OutPackageNames.Add(Package->GetFName());
+		}
+
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		AssetRegistry.ScanPathsSynchronous({ FString(ProjectPath) }, true);
+		return true;
+	}
+
+	// Metadata-only entries, so scan and filter can be measured at vault sizes no project export would reach.
+	static void GenerateVaultEntries(const FSettings& Settings, FRandomStream& Random)
+	{
+		const UEnum* AssetTypeEnum = StaticEnum<EAssetType>();
+		const int32 NumAssetTypes = AssetTypeEnum->NumEnums() - 1;
+
+		for (int32 Index = 0; Index < Settings.NumVaultEntries; ++Index)
+		{
+			FAssetExportOptions Options;
+			Options.MainInfo.Name = FString::Printf(TEXT("Synthetic_%05d"), Index);
+			// Skips EAssetType::All, which is a filter value only.
+			Options.MainInfo.AssetType = static_cast<EAssetType>(Random.RandRange(1, NumAssetTypes - 1));
+			Options.MainInfo.Description = FString::Printf(TEXT("Synthetic entry %d"), Index);
+			Options.MainInfo.EngineVersion = FString::Printf(TEXT("%d.%d"), FEngineVersion::Current().GetMajor(), FEngineVersion::Current().GetMinor());
+			Options.MainInfo.Version = TEXT("1.0");
+			Options.AdditionalInfo.Tags = { TEXT("Synthetic"), FString::Printf(TEXT("Group%d"), Index % 16) };
+			for (int32 AssetIndex = Random.RandRange(1, 8); AssetIndex > 0; --AssetIndex)
+			{
+				Options.MainInfo.ExportedAssetNames.Add(FString::Printf(TEXT("SM_Synthetic_%05d_%d"), Index, AssetIndex));
+			}
+
+			const FString ExportFolder = UAssetPackageManager::BuildExportPath(FPaths::Combine(Settings.VaultDir, TEXT("Synthetic")), Options.MainInfo);
+			Options.MainInfo.RelativeExportPath = ExportFolder;
+			FPaths::MakePathRelativeTo(Options.MainInfo.RelativeExportPath, *(Settings.VaultDir / TEXT("")));
+
+			TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+			JsonObject->SetStringField(TEXT("Name"), Options.MainInfo.Name);
+			JsonObject->SetStringField(TEXT("AssetType"), UEnum::GetValueAsString(Options.MainInfo.AssetType));
+			JsonObject->SetStringField(TEXT("Description"), Options.MainInfo.Description);
+			JsonObject->SetStringField(TEXT("EngineVersion"), Options.MainInfo.EngineVersion);
+			JsonObject->SetStringField(TEXT("Version"), Options.MainInfo.Version);
+			JsonObject->SetStringField(TEXT("RelativeExportPath"), Options.MainInfo.RelativeExportPath);
+
+			TArray<TSharedPtr<FJsonValue>> TagsJson;
+			for (const FString& Tag : Options.AdditionalInfo.Tags)
+			{
+				TagsJson.Add(MakeShared<FJsonValueString>(Tag));
+			}
+			JsonObject->SetArrayField(TEXT("Tags"), TagsJson);
+
+			TArray<TSharedPtr<FJsonValue>> AssetsJson;
+			for (const FString& AssetName : Options.MainInfo.ExportedAssetNames)
+			{
+				AssetsJson.Add(MakeShared<FJsonValueString>(AssetName));
+			}
+			JsonObject->SetArrayField(TEXT("Assets"), AssetsJson);
+
+			FString JsonText;
+			FJsonSerializer::Serialize(JsonObject, TJsonWriterFactory<>::Create(&JsonText));
+
+			IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+			PlatformFile.CreateDirectoryTree(*ExportFolder);
+			FAssetVaultMetadata::SaveToExportFolder(ExportFolder, FAssetVaultMetadata::MakeFileName(Options.MainInfo.Name, Options.MainInfo.AssetType), JsonText, Options);
+		}
+	}
+
+	static void WriteResults(const FSettings& Settings, const TArray<const FOperation*>& Operations)
+	{
+		const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("AssetVault"));
+		const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+		constexpr double MegaByte = 1024.0 * 1024.0;
+
+		FString Csv = TEXT("Operation,Calls,TotalSeconds,OpsPerSecond,MBPerSecond,P50Ms,P90Ms,P99Ms,MaxMs,PeakUsedMB,PeakGrowthMB\n");
+
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetStringField(TEXT("PluginVersion"), Plugin.IsValid() ? Plugin->GetDescriptor().VersionName : FString());
+		Root->SetStringField(TEXT("EngineVersion"), FEngineVersion::Current().ToString());
+		Root->SetStringField(TEXT("Platform"), FPlatformProperties::IniPlatformName());
+		Root->SetStringField(TEXT("Date"), FDateTime::UtcNow().ToIso8601());
+		Root->SetNumberField(TEXT("ProcessPeakUsedMB"), MemoryStats.PeakUsedPhysical / MegaByte);
+
+		TSharedRef<FJsonObject> SettingsJson = MakeShared<FJsonObject>();
+		SettingsJson->SetNumberField(TEXT("Packages"), Settings.NumPackages);
+		SettingsJson->SetNumberField(TEXT("FanOut"), Settings.FanOut);
+		SettingsJson->SetNumberField(TEXT("MinSizeKB"), Settings.MinSizeKB);
+		SettingsJson->SetNumberField(TEXT("MaxSizeKB"), Settings.MaxSizeKB);
+		SettingsJson->SetNumberField(TEXT("Exports"), Settings.NumExports);
+		SettingsJson->SetNumberField(TEXT("VaultEntries"), Settings.NumVaultEntries);
+		SettingsJson->SetNumberField(TEXT("Iterations"), Settings.Iterations);
+		SettingsJson->SetNumberField(TEXT("Seed"), Settings.Seed);
+		Root->SetObjectField(TEXT("Settings"), SettingsJson);
+
+		TArray<TSharedPtr<FJsonValue>> OperationsJson;
+		for (const FOperation* OperationPtr : Operations)
+		{
+			const FOperation& Operation = *OperationPtr;
+			const double TotalSeconds = Operation.GetTotalSeconds();
+			const double OpsPerSecond = TotalSeconds > 0.0 ? Operation.Latencies.Num() / TotalSeconds : 0.0;
+			const double MBPerSecond = TotalSeconds > 0.0 ? Operation.Bytes / MegaByte / TotalSeconds : 0.0;
+			const double PeakUsedMB = Operation.PeakUsedPhysical / MegaByte;
+			const double PeakGrowthMB = Operation.PeakGrowth / MegaByte;
+
+			Csv += FString::Printf(TEXT("%s,%d,%.4f,%.2f,%.2f,%.3f,%.3f,%.3f,%.3f,%.1f,%.1f\n"), *Operation.Name, Operation.Latencies.Num(), TotalSeconds,
+				OpsPerSecond, MBPerSecond, Operation.GetPercentileMs(50.0), Operation.GetPercentileMs(90.0), Operation.GetPercentileMs(99.0),
+				Operation.GetPercentileMs(100.0), PeakUsedMB, PeakGrowthMB);
+
+			TSharedRef<FJsonObject> OperationJson = MakeShared<FJsonObject>();
+			OperationJson->SetStringField(TEXT("Name"), Operation.Name);
+			OperationJson->SetNumberField(TEXT("Calls"), Operation.Latencies.Num());
+			OperationJson->SetNumberField(TEXT("TotalSeconds"), TotalSeconds);
+			OperationJson->SetNumberField(TEXT("OpsPerSecond"), OpsPerSecond);
+			OperationJson->SetNumberField(TEXT("Bytes"), static_cast<double>(Operation.Bytes));
+			OperationJson->SetNumberField(TEXT("MBPerSecond"), MBPerSecond);
+			OperationJson->SetNumberField(TEXT("P50Ms"), Operation.GetPercentileMs(50.0));
+			OperationJson->SetNumberField(TEXT("P90Ms"), Operation.GetPercentileMs(90.0));
+			OperationJson->SetNumberField(TEXT("P99Ms"), Operation.GetPercentileMs(99.0));
+			OperationJson->SetNumberField(TEXT("MaxMs"), Operation.GetPercentileMs(100.0));
+			OperationJson->SetNumberField(TEXT("PeakUsedMB"), PeakUsedMB);
+			OperationJson->SetNumberField(TEXT("PeakGrowthMB"), PeakGrowthMB);
+			OperationsJson.Add(MakeShared<FJsonValueObject>(OperationJson));
+
+			UE_LOG(LogAssetVault, Display, TEXT("Benchmark %-20s %5d calls, p50 %9.3f ms, p99 %9.3f ms, %8.2f MB/s"),
+				*Operation.Name, Operation.Latencies.Num(), Operation.GetPercentileMs(50.0), Operation.GetPercentileMs(99.0), MBPerSecond);
+		}
+		Root->SetArrayField(TEXT("Operations"), OperationsJson);
+
+		FString Json;
+		FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Json));
+
+		FFileHelper::SaveStringToFile(Csv, *FPaths::Combine(Settings.OutputDir, TEXT("AssetVaultBenchmark.csv")));
+		FFileHelper::SaveStringToFile(Json, *FPaths::Combine(Settings.OutputDir, TEXT("AssetVaultBenchmark.json")));
+		UE_LOG(LogAssetVault, Display, TEXT("Benchmark results written to %s"), *Settings.OutputDir);
+	}
+}
+
+UAssetVaultBenchmarkCommandlet::UAssetVaultBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAssetVaultBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace AssetVaultBenchmark;
+
+	FSettings Settings;
+	Settings.Parse(*Params);
+	FRandomStream Random(Settings.Seed);
+
+	const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectContentDir(), TEXT("AssetVaultBenchmark")));
+	const FString ImportDir = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectContentDir(), ImportSubfolder));
+	DeleteDirectory(Settings.VaultDir);
+	DeleteDirectory(ProjectDir);
+	DeleteDirectory(ImportDir);
+
+	const double GenerateStart = FPlatformTime::Seconds();
+	TArray<FName> PackageNames;
+	if (!GenerateProject(Settings, Random, PackageNames))
+	{
+		return 1;
+	}
+	GenerateVaultEntries(Settings, Random);
+	UE_LOG(LogAssetVault, Display, TEXT("Benchmark: generated %d packages and %d vault entries in %.2f s"),
+		PackageNames.Num(), Settings.NumVaultEntries, FPlatformTime::Seconds() - GenerateStart);
+
+	// The last packages have the deepest dependency closures.
+	TArray<FExport> Exports;
+	for (int32 Index = 0; Index < Settings.NumExports; ++Index)
+	{
+		FExport& Export = Exports.AddDefaulted_GetRef();
+		Export.RootPackage = PackageNames[PackageNames.Num() - 1 - Index];
+		Export.Options.MainInfo.Name = FString::Printf(TEXT("BenchExport_%03d"), Index);
+		Export.Options.MainInfo.AssetType = EAssetType::Other;
+		Export.Options.MainInfo.Version = TEXT("1.0");
+		Export.RelativeExportPath = UAssetPackageManager::BuildExportPath(Settings.VaultDir, Export.Options.MainInfo);
+		FPaths::MakePathRelativeTo(Export.RelativeExportPath, *(Settings.VaultDir / TEXT("")));
+	}
+
+	FOperation Export{ TEXT("Export") };
+	FOperation ExportIncremental{ TEXT("ExportIncremental") };
+	FOperation ExportPathCheck{ TEXT("ExportPathCheck") };
+	FOperation ScanCold{ TEXT("ScanCold") };
+	FOperation ScanWarm{ TEXT("ScanWarm") };
+	FOperation Filter{ TEXT("Filter") };
+	FOperation ConflictAnalysis{ TEXT("ConflictAnalysis") };
+	FOperation ConflictCheck{ TEXT("ConflictCheck") };
+	FOperation Import{ TEXT("Import") };
+	FOperation ReimportIdentical{ TEXT("ReimportIdentical") };
+
+	FMemorySampler Memory;
+	int32 NumFailures = 0;
+
+	for (int32 Iteration = 0; Iteration < Settings.Iterations; ++Iteration)
+	{
+		// The first pass copies everything, the later ones only find unchanged files.
+		FOperation& ExportOperation = Iteration == 0 ? Export : ExportIncremental;
+		for (const FExport& ExportJob : Exports)
+		{
+			FAssetVaultExportProgress Progress;
+			FString Message;
+			bool bExported = false;
+			ExportOperation.Time(Memory, [&]()
+			{
+				bExported = UAssetPackageManager::ExportPackagesToFolder({ ExportJob.RootPackage }, Settings.VaultDir, ExportJob.Options,
+					ExportJob.Options.MainInfo.Name, Message, &Progress);
+			});
+			ExportOperation.Bytes += Progress.Copy.BytesCopied.load();
+			NumFailures += bExported ? 0 : 1;
+
+			FString ResolvedPath;
+			ExportPathCheck.Time(Memory, [&]() { UAssetPackageManager::DoesExportPathAlreadyContainAssets(Settings.VaultDir, ExportJob.Options, ResolvedPath); });
+		}
+
+		ScanCold.Time(Memory, [&]()
+		{
+			IFileManager::Get().Delete(*FPaths::Combine(Settings.VaultDir, FAssetVaultCatalog::FileName), false, false, true);
+			UAssetPackageManager::LoadAllAssetDataFromDirectory(Settings.VaultDir);
+		});
+
+		TArray<FAssetExportOptions> Entries;
+		ScanWarm.Time(Memory, [&]() { Entries = UAssetPackageManager::LoadAllAssetDataFromDirectory(Settings.VaultDir); });
+
+		const UEnum* AssetTypeEnum = StaticEnum<EAssetType>();
+		for (int32 TypeIndex = 0; TypeIndex < AssetTypeEnum->NumEnums() - 1; ++TypeIndex)
+		{
+			Filter.Time(Memory, [&]() { UAssetPackageManager::FilterAndSortAssets(Entries, static_cast<EAssetType>(AssetTypeEnum->GetValueByIndex(TypeIndex))); });
+		}
+
+		FOperation& ImportOperation = Iteration == 0 ? Import : ReimportIdentical;
+		for (const FExport& ExportJob : Exports)
+		{
+			ConflictAnalysis.Time(Memory, [&]() { UAssetPackageManager::AnalyzeImportConflicts(Settings.VaultDir, ExportJob.RelativeExportPath, ImportSubfolder); });
+
+			TArray<FString> Conflicts;
+			ConflictCheck.Time(Memory, [&]() { UAssetPackageManager::DoesAssetAlreadyExist(Settings.VaultDir, ExportJob.RelativeExportPath, ImportSubfolder, Conflicts); });
+
+			bool bImported = false;
+			ImportOperation.Time(Memory, [&]()
+			{
+				bImported = UAssetPackageManager::ImportAssetFolderToProject(Settings.VaultDir, ExportJob.RelativeExportPath, ImportSubfolder, true);
+			});
+			NumFailures += bImported ? 0 : 1;
+		}
+	}
+
+	WriteResults(Settings, { &Export, &ExportIncremental, &ExportPathCheck, &ScanCold, &ScanWarm, &Filter,
+		&ConflictAnalysis, &ConflictCheck, &Import, &ReimportIdentical });
+
+	if (!Settings.bKeepData)
+	{
+		DeleteDirectory(Settings.VaultDir);
+		DeleteDirectory(ProjectDir);
+		DeleteDirectory(ImportDir);
+	}
+
+	if (NumFailures > 0)
+	{
+		UE_LOG(LogAssetVault, Error, TEXT("Benchmark: %d export or import call(s) failed"), NumFailures);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,70 @@
+#include "AssetVaultBlobStore.h"
+#include "AssetVaultCopyEngine.h"
+#include "AssetVaultFileCopy.h"
+#include "AssetVaultFileHash.h"
+
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+
+const TCHAR* FAssetVaultBlobStore::DirectoryName = TEXT(".AssetVaultBlobs");
+
+FAssetVaultBlobStore::FAssetVaultBlobStore(const FString& VaultRoot)
+	: Root(FPaths::Combine(VaultRoot, DirectoryName))
+{
+}
+
+FString FAssetVaultBlobStore::GetBlobPath(const FString& BlobRoot, const FString& Hash)
+{
+	return FPaths::Combine(BlobRoot, Hash.Left(2), Hash);
+}
+
+bool FAssetVaultBlobStore::Contains(const FString& Hash, int64 FileSize) const
+{
+	return FPlatformFileManager::Get().GetPlatformFile().FileSize(*GetBlobPath(Root, Hash)) == FileSize;
+}
+
+EAssetVaultCopyStatus FAssetVaultBlobStore::Store(const FString& SourceFile, int64 FileSize, bool bAllowClone, FString& OutHash, EAssetVaultCopyStrategy& OutStrategy) const
+{
+	OutStrategy = EAssetVaultCopyStrategy::None;
+
+	if (!FAssetVaultFileHash::HashFile(SourceFile, OutHash))
+	{
+		return EAssetVaultCopyStatus::Failed;
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString BlobPath = GetBlobPath(Root, OutHash);
+
+	if (Contains(OutHash, FileSize))
+	{
+		return EAssetVaultCopyStatus::Unchanged;
+	}
+
+	const FString BlobDir = FPaths::GetPath(BlobPath);
+	if (!PlatformFile.DirectoryExists(*BlobDir) && !PlatformFile.CreateDirectoryTree(*BlobDir))
+	{
+		return EAssetVaultCopyStatus::Failed;
+	}
+
+	// Write under a unique name and rename into place, so a concurrent export of the
+	// same content never observes a half-written blob.
+	const FString TempPath = BlobPath + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+	if (!FAssetVaultFileCopy::Copy(SourceFile, TempPath, bAllowClone, false, OutStrategy))
+	{
+		PlatformFile.DeleteFile(*TempPath);
+		return EAssetVaultCopyStatus::Failed;
+	}
+
+	if (!PlatformFile.MoveFile(*BlobPath, *TempPath))
+	{
+		PlatformFile.DeleteFile(*TempPath);
+		// Another writer may have won the race with identical content.
+		return PlatformFile.FileSize(*BlobPath) == FileSize ? EAssetVaultCopyStatus::Unchanged : EAssetVaultCopyStatus::Failed;
+	}
+
+	// Blobs are shared by every export referencing the content and may be hard linked into projects,
+	// so nothing may write into them in place.
+	PlatformFile.SetReadOnly(*BlobPath, true);
+	return EAssetVaultCopyStatus::Copied;
+}
@@ -0,0 +1,603 @@
+#include "AssetVaultCatalog.h"
+#include "AssetVault.h"
+#include "AssetVaultBlobStore.h"
+#include "AssetVaultMetadata.h"
+#include "AssetVaultSettings.h"
+#include "AssetVaultStats.h"
+
+#include "Async/ParallelFor.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/PathViews.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+struct FAssetVaultCatalog::FScanResult
+{
+	// Directory path relative to the vault root -> modification time.
+	TMap<FString, FDateTime> Directories;
+	// Directory path relative to the vault root -> metadata file names in it and their modification times.
+	TMap<FString, TArray<TPair<FString, FDateTime>>> JsonFiles;
+	// Binary metadata sidecar path relative to the vault root -> modification time.
+	TMap<FString, FDateTime> BinaryFiles;
+};
+
+struct FAssetVaultCatalog::FRefreshState
+{
+	struct FParseJob
+	{
+		FString RelativeDir;
+		FString FileName;
+		FDateTime Timestamp;
+		bool bHasBinary = false;
+	};
+
+	explicit FRefreshState(const FAssetVaultCatalogRefreshContext* InContext)
+		: Context(InContext)
+		, LastParseTime(FPlatformTime::Seconds())
+	{
+	}
+
+	bool IsCancelled() const { return Context && Context->IsCancelled(); }
+
+	const FAssetVaultCatalogRefreshContext* Context;
+	FScanResult Scan;
+	// Queued, not yet parsed metadata files, ordered by directory and file name.
+	TArray<FParseJob> PendingJobs;
+	// Previous entries of every re-read directory, to diff against once parsing is done.
+	TMap<FString, TArray<FAssetVaultCatalogEntry>> PreviousEntries;
+	int32 NumParsed = 0;
+	double LastParseTime = 0.0;
+};
+
+namespace AssetVaultCatalog
+{
+	using FDirectoryScan = FAssetVaultCatalog::FScanResult;
+
+	constexpr uint32 Magic = 0x54435641; // "AVCT"
+
+	// Bump whenever the layout of the catalog or of FAssetExportOptions changes.
+	constexpr uint32 Version = 2;
+
+	static FString MakeMetadataPath(const FString& RelativeDir, const FString& MetadataFile)
+	{
+		return RelativeDir.IsEmpty() ? MetadataFile : RelativeDir / MetadataFile;
+	}
+
+	// Lists every directory exactly once, taking file types and timestamps from the listing itself.
+	// The blob store is pruned, metadata files directly in the vault root are ignored. OnListed runs for each
+	// directory once its own listing is complete, returning false stops the walk.
+	static bool ScanDirectory(IPlatformFile& PlatformFile, const FString& Directory, const FString& RelativeDir, FDirectoryScan& Scan,
+		TFunctionRef<bool(const FString& RelativeDir)> OnListed)
+	{
+		TArray<TPair<FString, FString>> SubDirectories;
+
+		PlatformFile.IterateDirectoryStat(*Directory, [&RelativeDir, &Scan, &SubDirectories](const TCHAR* Path, const FFileStatData& StatData)
+		{
+			const FStringView Name = FPathViews::GetCleanFilename(Path);
+			if (StatData.bIsDirectory)
+			{
+				if (!Name.Equals(FAssetVaultBlobStore::DirectoryName, ESearchCase::IgnoreCase))
+				{
+					FString ChildRelativeDir = RelativeDir.IsEmpty() ? FString(Name) : RelativeDir / FString(Name);
+					Scan.Directories.Add(ChildRelativeDir, StatData.ModificationTime);
+					SubDirectories.Emplace(Path, MoveTemp(ChildRelativeDir));
+				}
+			}
+			else if (!RelativeDir.IsEmpty() && FPathViews::GetExtension(Name).Equals(TEXT("json"), ESearchCase::IgnoreCase))
+			{
+				Scan.JsonFiles.FindOrAdd(RelativeDir).Emplace(FString(Name), StatData.ModificationTime);
+			}
+			else if (!RelativeDir.IsEmpty() && FPathViews::GetExtension(Name).Equals(FAssetVaultMetadata::BinaryExtension, ESearchCase::IgnoreCase))
+			{
+				Scan.BinaryFiles.Add(RelativeDir / FString(Name), StatData.ModificationTime);
+			}
+			return true;
+		});
+
+		if (!OnListed(RelativeDir))
+		{
+			return false;
+		}
+
+		for (const TPair<FString, FString>& SubDirectory : SubDirectories)
+		{
+			if (!ScanDirectory(PlatformFile, SubDirectory.Key, SubDirectory.Value, Scan, OnListed))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static void SerializeOptions(FArchive& Ar, FAssetExportOptions& Options)
+	{
+		FAssetMainInfo& MainInfo = Options.MainInfo;
+
+		uint8 AssetType = static_cast<uint8>(MainInfo.AssetType);
+		Ar << AssetType;
+		// Entry views index per-type tables with it, a value past the enum fails the whole catalog, which is rebuilt.
+		if (AssetType > static_cast<uint8>(EAssetType::Other))
+		{
+			Ar.SetError();
+			return;
+		}
+		MainInfo.AssetType = static_cast<EAssetType>(AssetType);
+
+		Ar << MainInfo.Name << MainInfo.Description << MainInfo.EngineVersion << MainInfo.Version << MainInfo.VersionComment;
+		Ar << MainInfo.CustomFolder << MainInfo.CustomSubfolders << MainInfo.RelativeExportPath << MainInfo.ExportedAssetNames;
+		Ar << Options.AdditionalInfo.PreviewImagePaths << Options.AdditionalInfo.Tags;
+	}
+}
+
+const TCHAR* FAssetVaultCatalog::FileName = TEXT(".AssetVaultCatalog.bin");
+
+FAssetVaultCatalog::FAssetVaultCatalog(const FString& InVaultRoot)
+	: VaultRoot(InVaultRoot)
+{
+	FPaths::NormalizeDirectoryName(VaultRoot);
+}
+
+void FAssetVaultCatalog::Serialize(FArchive& Ar)
+{
+	int32 NumDirectories = Directories.Num();
+	Ar << NumDirectories;
+
+	if (Ar.IsLoading())
+	{
+		Directories.Empty(NumDirectories);
+		for (int32 DirIndex = 0; DirIndex < NumDirectories && !Ar.IsError(); ++DirIndex)
+		{
+			FString RelativeDir;
+			Ar << RelativeDir;
+
+			FDirectory& Directory = Directories.Add(RelativeDir);
+			Ar << Directory.Timestamp;
+
+			int32 NumEntries = 0;
+			Ar << NumEntries;
+			for (int32 EntryIndex = 0; EntryIndex < NumEntries && !Ar.IsError(); ++EntryIndex)
+			{
+				FAssetVaultCatalogEntry& Entry = Directory.Entries.AddDefaulted_GetRef();
+				Ar << Entry.MetadataFile << Entry.Timestamp;
+				AssetVaultCatalog::SerializeOptions(Ar, Entry.Options);
+			}
+		}
+		return;
+	}
+
+	for (TPair<FString, FDirectory>& Pair : Directories)
+	{
+		Ar << Pair.Key;
+		Ar << Pair.Value.Timestamp;
+
+		int32 NumEntries = Pair.Value.Entries.Num();
+		Ar << NumEntries;
+		for (FAssetVaultCatalogEntry& Entry : Pair.Value.Entries)
+		{
+			Ar << Entry.MetadataFile << Entry.Timestamp;
+			AssetVaultCatalog::SerializeOptions(Ar, Entry.Options);
+		}
+	}
+}
+
+bool FAssetVaultCatalog::Load()
+{
+	Directories.Empty();
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FPaths::Combine(VaultRoot, FileName), FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	uint32 PayloadCrc = 0;
+	Reader << Magic << Version << PayloadCrc;
+
+	const int64 PayloadOffset = Reader.Tell();
+	if (Reader.IsError() || Magic != AssetVaultCatalog::Magic || Version != AssetVaultCatalog::Version
+		|| FCrc::MemCrc32(Bytes.GetData() + PayloadOffset, static_cast<int32>(Bytes.Num() - PayloadOffset)) != PayloadCrc)
+	{
+		UE_LOG(LogAssetVault, Display, TEXT("Catalog is outdated or corrupt, rebuilding: %s"), *VaultRoot);
+		return false;
+	}
+
+	Serialize(Reader);
+	if (Reader.IsError())
+	{
+		Directories.Empty();
+		return false;
+	}
+	return true;
+}
+
+bool FAssetVaultCatalog::Save()
+{
+	TArray<uint8> Payload;
+	FMemoryWriter PayloadWriter(Payload);
+	Serialize(PayloadWriter);
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	uint32 Magic = AssetVaultCatalog::Magic;
+	uint32 Version = AssetVaultCatalog::Version;
+	uint32 PayloadCrc = FCrc::MemCrc32(Payload.GetData(), Payload.Num());
+	Writer << Magic << Version << PayloadCrc;
+	Bytes.Append(Payload);
+
+	// Other editors may read the catalog at any time, replace it in one rename.
+	const FString CatalogPath = FPaths::Combine(VaultRoot, FileName);
+	const FString TempPath = CatalogPath + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !IFileManager::Get().Move(*CatalogPath, *TempPath, true, true))
+	{
+		IFileManager::Get().Delete(*TempPath, false, false, true);
+		UE_LOG(LogAssetVault, Warning, TEXT("Failed to save catalog: %s"), *CatalogPath);
+		return false;
+	}
+	return true;
+}
+
+bool FAssetVaultCatalog::Refresh(const FAssetVaultCatalogRefreshContext* Context)
+{
+	ASSETVAULT_SCOPE(Scan);
+
+	FRefreshState State(Context);
+	const bool bCompleted = AssetVaultCatalog::ScanDirectory(FPlatformFileManager::Get().GetPlatformFile(), VaultRoot, FString(), State.Scan,
+		[this, &State](const FString& RelativeDir) { return QueueDirectory(State, RelativeDir); });
+
+	// A cancelled refresh skips the removals, directories not reached yet would look deleted.
+	return bCompleted ? FinishRefresh(State, TArray<FString>()) : true;
+}
+
+bool FAssetVaultCatalog::RefreshSubtrees(const TArray<FString>& RelativeDirs, const FAssetVaultCatalogRefreshContext* Context)
+{
+	TArray<FString> Scopes;
+	for (FString RelativeDir : RelativeDirs)
+	{
+		FPaths::NormalizeDirectoryName(RelativeDir);
+
+		// Editing a file in place leaves its directory timestamp alone, so the named directories are always re-read.
+		if (FDirectory* Directory = Directories.Find(RelativeDir))
+		{
+			Directory->Timestamp = FDateTime::MinValue();
+		}
+
+		if (RelativeDir.IsEmpty() || RelativeDir == TEXT("."))
+		{
+			return Refresh(Context);
+		}
+		Scopes.AddUnique(RelativeDir);
+	}
+
+	ASSETVAULT_SCOPE(Scan);
+
+	// Parents sort before children, drop scopes already covered by an ancestor.
+	Scopes.Sort();
+	for (int32 Index = Scopes.Num() - 1; Index > 0; --Index)
+	{
+		for (int32 ParentIndex = 0; ParentIndex < Index; ++ParentIndex)
+		{
+			if (Scopes[Index].StartsWith(Scopes[ParentIndex] + TEXT("/")))
+			{
+				Scopes.RemoveAt(Index);
+				break;
+			}
+		}
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	FRefreshState State(Context);
+	for (const FString& Scope : Scopes)
+	{
+		const FString AbsoluteDir = FPaths::Combine(VaultRoot, Scope);
+		const FFileStatData StatData = PlatformFile.GetStatData(*AbsoluteDir);
+		if (StatData.bIsValid && StatData.bIsDirectory && !Scope.Contains(FAssetVaultBlobStore::DirectoryName))
+		{
+			State.Scan.Directories.Add(Scope, StatData.ModificationTime);
+			if (!AssetVaultCatalog::ScanDirectory(PlatformFile, AbsoluteDir, Scope, State.Scan,
+				[this, &State](const FString& RelativeDir) { return QueueDirectory(State, RelativeDir); }))
+			{
+				return true;
+			}
+		}
+	}
+
+	return FinishRefresh(State, Scopes);
+}
+
+bool FAssetVaultCatalog::QueueDirectory(FRefreshState& State, const FString& RelativeDir)
+{
+	if (State.IsCancelled())
+	{
+		return false;
+	}
+
+	// The vault root itself holds no entries.
+	const FDateTime* ScannedTimestamp = State.Scan.Directories.Find(RelativeDir);
+	if (!ScannedTimestamp)
+	{
+		return true;
+	}
+
+	FDirectory& Directory = Directories.FindOrAdd(RelativeDir);
+	if (Directory.Timestamp == *ScannedTimestamp && *ScannedTimestamp != FDateTime::MinValue())
+	{
+		return true;
+	}
+
+	Directory.Timestamp = *ScannedTimestamp;
+	State.PreviousEntries.Add(RelativeDir, MoveTemp(Directory.Entries));
+	Directory.Entries.Reset();
+
+	if (TArray<TPair<FString, FDateTime>>* JsonFiles = State.Scan.JsonFiles.Find(RelativeDir))
+	{
+		JsonFiles->Sort([](const TPair<FString, FDateTime>& A, const TPair<FString, FDateTime>& B) { return A.Key < B.Key; });
+		for (TPair<FString, FDateTime>& JsonFile : *JsonFiles)
+		{
+			// A sidecar older than its JSON means the JSON was edited by hand, and the JSON wins.
+			const FDateTime* BinaryTimestamp = State.Scan.BinaryFiles.Find(FAssetVaultMetadata::GetBinaryPath(RelativeDir / JsonFile.Key));
+			const bool bHasBinary = BinaryTimestamp && *BinaryTimestamp >= JsonFile.Value;
+			State.PendingJobs.Add({ RelativeDir, MoveTemp(JsonFile.Key), JsonFile.Value, bHasBinary });
+		}
+	}
+
+	// Without a context everything is parsed at the end, in one parallel pass.
+	const FAssetVaultCatalogRefreshContext* Context = State.Context;
+	if (!Context || State.PendingJobs.IsEmpty())
+	{
+		return true;
+	}
+
+	const bool bBatchFull = State.PendingJobs.Num() >= FMath::Max(Context->BatchSize, 1);
+	const bool bBatchDue = Context->OnEntriesParsed && FPlatformTime::Seconds() - State.LastParseTime >= Context->MaxBatchDelaySeconds;
+	return (bBatchFull || bBatchDue) ? ParsePending(State) : true;
+}
+
+bool FAssetVaultCatalog::ParsePending(FRefreshState& State)
+{
+	const FAssetVaultCatalogRefreshContext* Context = State.Context;
+	TArray<FRefreshState::FParseJob>& ParseJobs = State.PendingJobs;
+
+	const EParallelForFlags ParseFlags = GetDefault<UAssetVaultSettings>()->bParallelMetadataScan
+		? EParallelForFlags::None
+		: EParallelForFlags::ForceSingleThread;
+
+	const int32 BatchSize = Context ? FMath::Max(Context->BatchSize, 1) : FMath::Max(ParseJobs.Num(), 1);
+
+	TArray<FAssetVaultCatalogEntry> ParsedEntries;
+	TArray<bool> ParseSucceeded;
+
+	for (int32 BatchStart = 0; BatchStart < ParseJobs.Num(); BatchStart += BatchSize)
+	{
+		if (State.IsCancelled())
+		{
+			return false;
+		}
+
+		const int32 BatchNum = FMath::Min(BatchSize, ParseJobs.Num() - BatchStart);
+		ParsedEntries.Reset();
+		ParsedEntries.SetNum(BatchNum);
+		ParseSucceeded.Reset();
+		ParseSucceeded.SetNumZeroed(BatchNum);
+
+		ParallelFor(BatchNum, [this, BatchStart, &ParseJobs, &ParsedEntries, &ParseSucceeded](int32 Index)
+		{
+			ASSETVAULT_SCOPE(Parse);
+			ASSETVAULT_COUNT(FilesParsed, 1);
+
+			const FRefreshState::FParseJob& Job = ParseJobs[BatchStart + Index];
+			FAssetVaultCatalogEntry& Entry = ParsedEntries[Index];
+			Entry.MetadataFile = Job.FileName;
+			Entry.Timestamp = Job.Timestamp;
+			const FString JsonPath = FPaths::Combine(VaultRoot, Job.RelativeDir, Job.FileName);
+			ParseSucceeded[Index] = (Job.bHasBinary && FAssetVaultMetadata::LoadFromBinaryFile(FAssetVaultMetadata::GetBinaryPath(JsonPath), Entry.Options))
+				|| FAssetVaultMetadata::LoadFromJsonFile(JsonPath, Entry.Options);
+		}, ParseFlags);
+
+		TArray<FAssetExportOptions> BatchOptions;
+		const bool bReportBatch = Context && Context->OnEntriesParsed;
+
+		// Jobs are ordered by directory and file name, so entries land in a deterministic order.
+		for (int32 Index = 0; Index < BatchNum; ++Index)
+		{
+			if (!ParseSucceeded[Index])
+			{
+				continue;
+			}
+			if (bReportBatch)
+			{
+				BatchOptions.Add(ParsedEntries[Index].Options);
+			}
+			Directories.FindChecked(ParseJobs[BatchStart + Index].RelativeDir).Entries.Add(MoveTemp(ParsedEntries[Index]));
+		}
+
+		if (bReportBatch && BatchOptions.Num() > 0)
+		{
+			Context->OnEntriesParsed(MoveTemp(BatchOptions));
+		}
+	}
+
+	State.NumParsed += ParseJobs.Num();
+	ParseJobs.Reset();
+	State.LastParseTime = FPlatformTime::Seconds();
+	return true;
+}
+
+bool FAssetVaultCatalog::FinishRefresh(FRefreshState& State, const TArray<FString>& Scopes)
+{
+	if (!ParsePending(State))
+	{
+		return true;
+	}
+
+	FAssetVaultChangeSet* Changes = State.Context ? State.Context->Changes : nullptr;
+	const FScanResult& Scan = State.Scan;
+	TMap<FString, TArray<FAssetVaultCatalogEntry>>& PreviousEntries = State.PreviousEntries;
+
+	if (Changes)
+	{
+		for (TPair<FString, TArray<FAssetVaultCatalogEntry>>& Previous : PreviousEntries)
+		{
+			const TArray<FAssetVaultCatalogEntry>& CurrentEntries = Directories.FindChecked(Previous.Key).Entries;
+
+			for (const FAssetVaultCatalogEntry& Entry : CurrentEntries)
+			{
+				const FAssetVaultCatalogEntry* Old = Previous.Value.FindByPredicate([&Entry](const FAssetVaultCatalogEntry& Candidate)
+				{
+					return Candidate.MetadataFile == Entry.MetadataFile;
+				});
+				if (!Old)
+				{
+					Changes->Added.Add(Entry.Options);
+					Changes->AddedFiles.Add(AssetVaultCatalog::MakeMetadataPath(Previous.Key, Entry.MetadataFile));
+				}
+				else if (!FAssetExportOptions::StaticStruct()->CompareScriptStruct(&Old->Options, &Entry.Options, PPF_None))
+				{
+					Changes->Modified.Add(Entry.Options);
+					Changes->ModifiedFiles.Add(AssetVaultCatalog::MakeMetadataPath(Previous.Key, Entry.MetadataFile));
+				}
+			}
+
+			for (const FAssetVaultCatalogEntry& Old : Previous.Value)
+			{
+				const bool bStillThere = CurrentEntries.ContainsByPredicate([&Old](const FAssetVaultCatalogEntry& Entry)
+				{
+					return Old.MetadataFile == Entry.MetadataFile;
+				});
+				if (!bStillThere)
+				{
+					Changes->Removed.Add(Old.Options);
+					Changes->RemovedFiles.Add(AssetVaultCatalog::MakeMetadataPath(Previous.Key, Old.MetadataFile));
+				}
+			}
+		}
+	}
+
+	auto IsInScope = [&Scopes](const FString& RelativeDir)
+	{
+		if (Scopes.IsEmpty())
+		{
+			return true;
+		}
+		for (const FString& Scope : Scopes)
+		{
+			if (RelativeDir == Scope || RelativeDir.StartsWith(Scope + TEXT("/")))
+			{
+				return true;
+			}
+		}
+		return false;
+	};
+
+	int32 NumRemoved = 0;
+	for (auto It = Directories.CreateIterator(); It; ++It)
+	{
+		if (!Scan.Directories.Contains(It.Key()) && IsInScope(It.Key()))
+		{
+			if (Changes)
+			{
+				for (const FAssetVaultCatalogEntry& Entry : It.Value().Entries)
+				{
+					Changes->Removed.Add(Entry.Options);
+					Changes->RemovedFiles.Add(AssetVaultCatalog::MakeMetadataPath(It.Key(), Entry.MetadataFile));
+				}
+			}
+			It.RemoveCurrent();
+			++NumRemoved;
+		}
+	}
+
+	const bool bChanged = PreviousEntries.Num() > 0 || NumRemoved > 0;
+	if (bChanged)
+	{
+		Directories.KeySort(TLess<FString>());
+	}
+
+	UE_LOG(LogAssetVault, Log, TEXT("Catalog refresh: %d directories, %d re-read, %d metadata files parsed, %d removed"),
+		Scan.Directories.Num(), PreviousEntries.Num(), State.NumParsed, NumRemoved);
+	return bChanged;
+}
+
+void FAssetVaultCatalog::GetAllEntries(TArray<FAssetExportOptions>& OutEntries) const
+{
+	OutEntries.Reserve(OutEntries.Num() + NumEntries());
+	for (const TPair<FString, FDirectory>& Pair : Directories)
+	{
+		for (const FAssetVaultCatalogEntry& Entry : Pair.Value.Entries)
+		{
+			OutEntries.Add(Entry.Options);
+		}
+	}
+}
+
+void FAssetVaultCatalog::ForEachEntry(TFunctionRef<void(const FString& MetadataPath, const FAssetVaultCatalogEntry& Entry)> Visitor) const
+{
+	for (const TPair<FString, FDirectory>& Pair : Directories)
+	{
+		for (const FAssetVaultCatalogEntry& Entry : Pair.Value.Entries)
+		{
+			Visitor(AssetVaultCatalog::MakeMetadataPath(Pair.Key, Entry.MetadataFile), Entry);
+		}
+	}
+}
+
+const FAssetVaultCatalogEntry* FAssetVaultCatalog::FindEntry(const FString& MetadataPath) const
+{
+	const FDirectory* Directory = Directories.Find(FPaths::GetPath(MetadataPath));
+	if (!Directory)
+	{
+		return nullptr;
+	}
+
+	const FString MetadataFile = FPaths::GetCleanFilename(MetadataPath);
+	return Directory->Entries.FindByPredicate([&MetadataFile](const FAssetVaultCatalogEntry& Entry)
+	{
+		return Entry.MetadataFile == MetadataFile;
+	});
+}
+
+void FAssetVaultCatalog::ForEachBatch(int32 BatchSize, TFunctionRef<void(TArray<FAssetExportOptions>&&)> Visitor) const
+{
+	BatchSize = FMath::Max(BatchSize, 1);
+
+	TArray<FAssetExportOptions> Batch;
+	Batch.Reserve(BatchSize);
+
+	for (const TPair<FString, FDirectory>& Pair : Directories)
+	{
+		for (const FAssetVaultCatalogEntry& Entry : Pair.Value.Entries)
+		{
+			Batch.Add(Entry.Options);
+			if (Batch.Num() == BatchSize)
+			{
+				Visitor(MoveTemp(Batch));
+				Batch.Reset();
+				Batch.Reserve(BatchSize);
+			}
+		}
+	}
+
+	if (Batch.Num() > 0)
+	{
+		Visitor(MoveTemp(Batch));
+	}
+}
+
+int32 FAssetVaultCatalog::NumEntries() const
+{
+	int32 Count = 0;
+	for (const TPair<FString, FDirectory>& Pair : Directories)
+	{
+		Count += Pair.Value.Entries.Num();
+	}
+	return Count;
+}
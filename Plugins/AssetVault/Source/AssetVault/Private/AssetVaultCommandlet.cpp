@@ -0,0 +1,319 @@
+#include "AssetVaultCommandlet.h"
+#include "AssetVault.h"
+#include "AssetVaultJournal.h"
+#include "FAssetPackageManager.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "JsonObjectConverter.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace AssetVaultCommandlet
+{
+	struct FSettings
+	{
+		FString BatchFile;
+		FString VaultDir;
+		FString ReportFile;
+		FString JournalFile;
+		bool bStopOnError = false;
+
+		void Parse(const TCHAR* Params)
+		{
+			FParse::Value(Params, TEXT("Batch="), BatchFile);
+			FParse::Value(Params, TEXT("Vault="), VaultDir);
+			FParse::Value(Params, TEXT("Journal="), JournalFile);
+			bStopOnError = FParse::Param(Params, TEXT("StopOnError"));
+
+			ReportFile = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AssetVault"), TEXT("AssetVaultReport.json"));
+			FParse::Value(Params, TEXT("Report="), ReportFile);
+			ReportFile = FPaths::ConvertRelativePathToFull(ReportFile);
+		}
+	};
+
+	static TArray<FString> GetStringArray(const FJsonObject& Object, const TCHAR* Field)
+	{
+		TArray<FString> Values;
+		Object.TryGetStringArrayField(Field, Values);
+		return Values;
+	}
+
+	// Accepts package names and object paths in "Assets", content folders (recursive) in "Paths".
+	static bool CollectRootPackages(const FJsonObject& ExportJson, IAssetRegistry& AssetRegistry, TArray<FName>& OutPackages, FString& OutMessage)
+	{
+		for (const FString& AssetPath : GetStringArray(ExportJson, TEXT("Assets")))
+		{
+			const FString PackageName = FPackageName::ObjectPathToPackageName(AssetPath);
+			if (!FPackageName::DoesPackageExist(PackageName))
+			{
+				OutMessage = FString::Printf(TEXT("Package does not exist: %s"), *PackageName);
+				return false;
+			}
+			OutPackages.AddUnique(FName(*PackageName));
+		}
+
+		for (const FString& ContentPath : GetStringArray(ExportJson, TEXT("Paths")))
+		{
+			TArray<FAssetData> Assets;
+			AssetRegistry.GetAssetsByPath(FName(*ContentPath), Assets, true);
+			if (Assets.IsEmpty())
+			{
+				OutMessage = FString::Printf(TEXT("No assets under: %s"), *ContentPath);
+				return false;
+			}
+			for (const FAssetData& Asset : Assets)
+			{
+				OutPackages.AddUnique(Asset.PackageName);
+			}
+		}
+
+		if (OutPackages.IsEmpty())
+		{
+			OutMessage = TEXT("Export job has no assets");
+			return false;
+		}
+		return true;
+	}
+
+	static TSharedRef<FJsonObject> RunExport(const FJsonObject& ExportJson, const FString& VaultDir, IAssetRegistry& AssetRegistry, bool& bOutSuccess)
+	{
+		TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+		Result->SetStringField(TEXT("Type"), TEXT("Export"));
+
+		FAssetExportOptions Options;
+		const TSharedPtr<FJsonObject>* OptionsJson = nullptr;
+		if (ExportJson.TryGetObjectField(TEXT("Options"), OptionsJson))
+		{
+			FJsonObjectConverter::JsonObjectToUStruct((*OptionsJson).ToSharedRef(), &Options);
+		}
+		Result->SetStringField(TEXT("Name"), Options.MainInfo.Name);
+
+		FString Message;
+		TArray<FName> RootPackages;
+		if (Options.MainInfo.Name.IsEmpty())
+		{
+			Message = TEXT("Export job has no MainInfo.Name");
+			bOutSuccess = false;
+		}
+		else
+		{
+			bOutSuccess = CollectRootPackages(ExportJson, AssetRegistry, RootPackages, Message);
+		}
+
+		if (bOutSuccess)
+		{
+			const FString TargetFolder = UAssetPackageManager::BuildExportPath(VaultDir, Options.MainInfo);
+			FString RelativeExportPath = TargetFolder;
+			FPaths::MakePathRelativeTo(RelativeExportPath, *(VaultDir / TEXT("")));
+
+			FAssetVaultExportProgress Progress;
+			const double StartTime = FPlatformTime::Seconds();
+			bOutSuccess = UAssetPackageManager::ExportPackagesToFolder(RootPackages, VaultDir, Options, Options.MainInfo.Name, Message, &Progress);
+
+			Result->SetStringField(TEXT("RelativeExportPath"), RelativeExportPath);
+			Result->SetNumberField(TEXT("RootPackages"), RootPackages.Num());
+			Result->SetNumberField(TEXT("PackagesResolved"), Progress.PackagesResolved.load());
+			Result->SetNumberField(TEXT("FilesProcessed"), Progress.Copy.JobsDone.load());
+			Result->SetNumberField(TEXT("BytesCopied"), static_cast<double>(Progress.Copy.BytesCopied.load()));
+			Result->SetNumberField(TEXT("Seconds"), FPlatformTime::Seconds() - StartTime);
+		}
+
+		Result->SetBoolField(TEXT("Success"), bOutSuccess);
+		if (!Message.IsEmpty())
+		{
+			Result->SetStringField(TEXT("Message"), Message);
+		}
+		return Result;
+	}
+
+	static TSharedRef<FJsonObject> RunImport(const FJsonObject& ImportJson, const FString& VaultDir, bool& bOutSuccess)
+	{
+		TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+		Result->SetStringField(TEXT("Type"), TEXT("Import"));
+
+		FString Entry;
+		ImportJson.TryGetStringField(TEXT("Entry"), Entry);
+		FString TargetSubfolder;
+		ImportJson.TryGetStringField(TEXT("TargetSubfolder"), TargetSubfolder);
+		bool bOverwrite = false;
+		ImportJson.TryGetBoolField(TEXT("Overwrite"), bOverwrite);
+
+		Result->SetStringField(TEXT("Entry"), Entry);
+		Result->SetStringField(TEXT("TargetSubfolder"), TargetSubfolder);
+
+		if (Entry.IsEmpty() || !FPaths::DirectoryExists(FPaths::Combine(VaultDir, Entry)))
+		{
+			bOutSuccess = false;
+			Result->SetBoolField(TEXT("Success"), false);
+			Result->SetStringField(TEXT("Message"), FString::Printf(TEXT("Vault entry does not exist: %s"), *Entry));
+			return Result;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		FAssetVaultImportResult ImportResult;
+		bOutSuccess = UAssetPackageManager::ImportPackagesFromFolder(VaultDir, Entry, TargetSubfolder, bOverwrite, ImportResult);
+
+		Result->SetBoolField(TEXT("Success"), bOutSuccess);
+		Result->SetNumberField(TEXT("NewFiles"), ImportResult.NumNew);
+		Result->SetNumberField(TEXT("IdenticalFiles"), ImportResult.NumIdentical);
+		Result->SetNumberField(TEXT("ModifiedFiles"), ImportResult.NumModified);
+		Result->SetNumberField(TEXT("Copied"), ImportResult.NumCopied);
+		Result->SetNumberField(TEXT("Replaced"), ImportResult.NumReplaced);
+		Result->SetNumberField(TEXT("SkippedExisting"), ImportResult.NumSkippedExisting);
+		Result->SetNumberField(TEXT("Failed"), ImportResult.NumFailed);
+		Result->SetNumberField(TEXT("BytesCopied"), static_cast<double>(ImportResult.BytesCopied));
+		Result->SetNumberField(TEXT("Seconds"), FPlatformTime::Seconds() - StartTime);
+		return Result;
+	}
+
+	static TArray<TSharedPtr<FJsonObject>> GetObjectArray(const FJsonObject& Object, const TCHAR* Field)
+	{
+		TArray<TSharedPtr<FJsonObject>> Objects;
+		const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+		if (Object.TryGetArrayField(Field, Values))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *Values)
+			{
+				const TSharedPtr<FJsonObject>* ValueObject = nullptr;
+				if (Value.IsValid() && Value->TryGetObject(ValueObject))
+				{
+					Objects.Add(*ValueObject);
+				}
+			}
+		}
+		return Objects;
+	}
+}
+
+UAssetVaultCommandlet::UAssetVaultCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAssetVaultCommandlet::Main(const FString& Params)
+{
+	using namespace AssetVaultCommandlet;
+
+	FSettings Settings;
+	Settings.Parse(*Params);
+
+	FString BatchText;
+	if (Settings.BatchFile.IsEmpty() || !FFileHelper::LoadFileToString(BatchText, *Settings.BatchFile))
+	{
+		UE_LOG(LogAssetVault, Error, TEXT("Cannot read batch file '%s', pass it with -Batch=<File.json>"), *Settings.BatchFile);
+		return 1;
+	}
+
+	TSharedPtr<FJsonObject> Batch;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BatchText), Batch) || !Batch.IsValid())
+	{
+		UE_LOG(LogAssetVault, Error, TEXT("Failed to parse batch file: %s"), *Settings.BatchFile);
+		return 1;
+	}
+
+	if (Settings.VaultDir.IsEmpty())
+	{
+		Batch->TryGetStringField(TEXT("Vault"), Settings.VaultDir);
+	}
+	if (Settings.VaultDir.IsEmpty())
+	{
+		UE_LOG(LogAssetVault, Error, TEXT("No vault directory, set \"Vault\" in the batch file or pass -Vault=<Dir>"));
+		return 1;
+	}
+	Settings.VaultDir = FPaths::ConvertRelativePathToFull(Settings.VaultDir);
+
+	const TArray<TSharedPtr<FJsonObject>> ExportJobs = GetObjectArray(*Batch, TEXT("Exports"));
+	const TArray<TSharedPtr<FJsonObject>> ImportJobs = GetObjectArray(*Batch, TEXT("Imports"));
+
+	// One full scan for the whole batch, exports and the dependency cache work from it.
+	const double StartTime = FPlatformTime::Seconds();
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.SearchAllAssets(true);
+	UE_LOG(LogAssetVault, Display, TEXT("Asset registry ready in %.2f s, running %d export(s) and %d import(s) against %s"),
+		FPlatformTime::Seconds() - StartTime, ExportJobs.Num(), ImportJobs.Num(), *Settings.VaultDir);
+
+	TArray<TSharedPtr<FJsonValue>> JobsJson;
+	int32 NumSucceeded = 0;
+	int32 NumFailed = 0;
+
+	auto Record = [&](const TSharedRef<FJsonObject>& Result, bool bSuccess)
+	{
+		JobsJson.Add(MakeShared<FJsonValueObject>(Result));
+		if (bSuccess)
+		{
+			++NumSucceeded;
+		}
+		else
+		{
+			++NumFailed;
+		}
+
+		FString Message;
+		Result->TryGetStringField(TEXT("Message"), Message);
+		UE_LOG(LogAssetVault, Display, TEXT("[%d/%d] %s %s: %s%s%s"), JobsJson.Num(), ExportJobs.Num() + ImportJobs.Num(),
+			*Result->GetStringField(TEXT("Type")), *Result->GetStringField(Result->HasField(TEXT("Name")) ? TEXT("Name") : TEXT("Entry")),
+			bSuccess ? TEXT("ok") : TEXT("FAILED"), Message.IsEmpty() ? TEXT("") : TEXT(" - "), *Message);
+		return bSuccess || !Settings.bStopOnError;
+	};
+
+	bool bContinue = true;
+	for (int32 Index = 0; bContinue && Index < ExportJobs.Num(); ++Index)
+	{
+		bool bSuccess = false;
+		const TSharedRef<FJsonObject> Result = RunExport(*ExportJobs[Index], Settings.VaultDir, AssetRegistry, bSuccess);
+		bContinue = Record(Result, bSuccess);
+	}
+	for (int32 Index = 0; bContinue && Index < ImportJobs.Num(); ++Index)
+	{
+		bool bSuccess = false;
+		const TSharedRef<FJsonObject> Result = RunImport(*ImportJobs[Index], Settings.VaultDir, bSuccess);
+		bContinue = Record(Result, bSuccess);
+	}
+
+	// Brings the vault catalog up to date, so the next editor opening the vault does not rebuild it.
+	if (!ExportJobs.IsEmpty())
+	{
+		UAssetPackageManager::LoadAllAssetDataFromDirectory(Settings.VaultDir);
+	}
+
+	const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("BatchFile"), FPaths::ConvertRelativePathToFull(Settings.BatchFile));
+	Report->SetStringField(TEXT("Vault"), Settings.VaultDir);
+	Report->SetStringField(TEXT("Date"), FDateTime::UtcNow().ToIso8601());
+	Report->SetNumberField(TEXT("Succeeded"), NumSucceeded);
+	Report->SetNumberField(TEXT("Failed"), NumFailed);
+	Report->SetNumberField(TEXT("Skipped"), ExportJobs.Num() + ImportJobs.Num() - JobsJson.Num());
+	Report->SetNumberField(TEXT("Seconds"), TotalSeconds);
+	Report->SetArrayField(TEXT("Jobs"), JobsJson);
+
+	FString ReportText;
+	FJsonSerializer::Serialize(Report, TJsonWriterFactory<>::Create(&ReportText));
+	if (!FFileHelper::SaveStringToFile(ReportText, *Settings.ReportFile))
+	{
+		UE_LOG(LogAssetVault, Error, TEXT("Failed to write report: %s"), *Settings.ReportFile);
+		return 1;
+	}
+
+	if (!Settings.JournalFile.IsEmpty())
+	{
+		FAssetVaultJournal::Get().DumpToJson(FPaths::ConvertRelativePathToFull(Settings.JournalFile));
+	}
+
+	UE_LOG(LogAssetVault, Display, TEXT("Batch finished in %.2f s: %d succeeded, %d failed. Report: %s"),
+		TotalSeconds, NumSucceeded, NumFailed, *Settings.ReportFile);
+	return NumFailed > 0 ? 1 : 0;
+}
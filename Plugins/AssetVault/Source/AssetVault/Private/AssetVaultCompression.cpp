@@ -0,0 +1,77 @@
+#include "AssetVaultCompression.h"
+#include "AssetVaultSettings.h"
+
+#include "Compression/OodleDataCompression.h"
+#include "Misc/Compression.h"
+
+namespace AssetVaultCompression
+{
+	static FOodleDataCompression::ECompressor GetOodleCompressor(EAssetVaultCompressionCodec Codec)
+	{
+		switch (Codec)
+		{
+		case EAssetVaultCompressionCodec::Selkie:		return FOodleDataCompression::ECompressor::Selkie;
+		case EAssetVaultCompressionCodec::Kraken:		return FOodleDataCompression::ECompressor::Kraken;
+		case EAssetVaultCompressionCodec::Leviathan:	return FOodleDataCompression::ECompressor::Leviathan;
+		default:										return FOodleDataCompression::ECompressor::Mermaid;
+		}
+	}
+}
+
+FName FAssetVaultCompression::GetFormatName(EAssetVaultCompressionCodec Codec)
+{
+	switch (Codec)
+	{
+	case EAssetVaultCompressionCodec::None:	return NAME_None;
+	case EAssetVaultCompressionCodec::Zlib:	return NAME_Zlib;
+	case EAssetVaultCompressionCodec::LZ4:	return NAME_LZ4;
+	default:								return NAME_Oodle;
+	}
+}
+
+bool FAssetVaultCompression::Compress(EAssetVaultCompressionCodec Codec, int32 Level, const uint8* Data, int64 Size, TArray<uint8>& OutCompressed)
+{
+	const FName FormatName = GetFormatName(Codec);
+	if (FormatName.IsNone() || Size <= 0)
+	{
+		return false;
+	}
+
+	int64 CompressedSize = 0;
+	if (FormatName == NAME_Oodle)
+	{
+		OutCompressed.SetNumUninitialized(FOodleDataCompression::CompressedBufferSizeNeeded(Size), EAllowShrinking::No);
+		CompressedSize = FOodleDataCompression::Compress(OutCompressed.GetData(), OutCompressed.Num(), Data, Size,
+			AssetVaultCompression::GetOodleCompressor(Codec),
+			static_cast<FOodleDataCompression::ECompressionLevel>(FMath::Clamp(Level, -4, 9)));
+	}
+	else
+	{
+		const ECompressionFlags Flags = Level < 4 ? COMPRESS_BiasSpeed : (Level > 5 ? COMPRESS_BiasSize : COMPRESS_NoFlags);
+
+		int32 BufferSize = FCompression::CompressMemoryBound(FormatName, static_cast<int32>(Size), Flags);
+		OutCompressed.SetNumUninitialized(BufferSize, EAllowShrinking::No);
+		if (FCompression::CompressMemory(FormatName, OutCompressed.GetData(), BufferSize, Data, static_cast<int32>(Size), Flags))
+		{
+			CompressedSize = BufferSize;
+		}
+	}
+
+	if (CompressedSize <= 0 || CompressedSize >= Size)
+	{
+		return false;
+	}
+
+	OutCompressed.SetNum(static_cast<int32>(CompressedSize), EAllowShrinking::No);
+	return true;
+}
+
+bool FAssetVaultCompression::Decompress(FName FormatName, const uint8* Compressed, int64 CompressedSize, uint8* OutData, int64 Size)
+{
+	if (FormatName == NAME_Oodle)
+	{
+		return FOodleDataCompression::Decompress(OutData, Size, Compressed, CompressedSize);
+	}
+	return !FormatName.IsNone()
+		&& FCompression::UncompressMemory(FormatName, OutData, static_cast<int32>(Size), Compressed, static_cast<int32>(CompressedSize));
+}
@@ -0,0 +1,293 @@
+#include "AssetVaultCopyEngine.h"
+#include "AssetVault.h"
+#include "AssetVaultArchive.h"
+#include "AssetVaultBlobStore.h"
+#include "AssetVaultFileHash.h"
+#include "AssetVaultFileManifest.h"
+#include "AssetVaultStats.h"
+#include "AssetVaultSettings.h"
+
+#include "Async/ParallelFor.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+
+#include <atomic>
+
+void FAssetVaultCopyReport::Append(const FAssetVaultCopyReport& Other)
+{
+	Results.Append(Other.Results);
+	TotalBytes += Other.TotalBytes;
+	NumCopied += Other.NumCopied;
+	NumFailed += Other.NumFailed;
+	NumMissing += Other.NumMissing;
+	NumUnchanged += Other.NumUnchanged;
+	Seconds += Other.Seconds;
+	bCancelled |= Other.bCancelled;
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(NumByStrategy); ++Index)
+	{
+		NumByStrategy[Index] += Other.NumByStrategy[Index];
+	}
+}
+
+FString FAssetVaultCopyReport::DescribeStrategies() const
+{
+	FString Description;
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(NumByStrategy); ++Index)
+	{
+		if (NumByStrategy[Index] > 0)
+		{
+			Description += FString::Printf(TEXT("%s%d %s"), Description.IsEmpty() ? TEXT("") : TEXT(", "),
+				NumByStrategy[Index], FAssetVaultFileCopy::GetStrategyName(static_cast<EAssetVaultCopyStrategy>(Index)));
+		}
+	}
+	return Description.IsEmpty() ? TEXT("nothing written") : Description;
+}
+
+FAssetVaultCopyEngine::FAssetVaultCopyEngine(int32 InNumWorkers)
+{
+	NumWorkers = InNumWorkers > 0
+		? InNumWorkers
+		: GetDefault<UAssetVaultSettings>()->GetEffectiveCopyWorkerCount();
+	bUseFileClones = GetDefault<UAssetVaultSettings>()->bUseFileClones;
+}
+
+const TArray<FString>& FAssetVaultCopyEngine::GetPackageExtensions()
+{
+	// The first two are the main package files, a package has exactly one of them.
+	static const TArray<FString> Extensions = { TEXT(".uasset"), TEXT(".umap"), TEXT(".uexp"), TEXT(".ubulk"), TEXT(".uptnl") };
+	return Extensions;
+}
+
+FAssetVaultCopyReport FAssetVaultCopyEngine::Run(const TArray<FAssetVaultCopyJob>& Jobs) const
+{
+	ASSETVAULT_SCOPE(Copy);
+
+	FAssetVaultCopyReport Report;
+	const double StartTime = FPlatformTime::Seconds();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	TSet<FString> TargetDirectories;
+	if (BlobStore)
+	{
+		TargetDirectories.Add(BlobStore->GetRoot());
+	}
+	else if (!ArchiveWriter)
+	{
+		for (const FAssetVaultCopyJob& Job : Jobs)
+		{
+			TargetDirectories.Add(FPaths::GetPath(Job.TargetPath));
+		}
+	}
+
+	// Parents sort before their children, so CreateDirectoryTree only walks each level once.
+	TArray<FString> SortedDirectories = TargetDirectories.Array();
+	SortedDirectories.Sort();
+	for (const FString& Directory : SortedDirectories)
+	{
+		if (!PlatformFile.CreateDirectoryTree(*Directory))
+		{
+			UE_LOG(LogAssetVault, Error, TEXT("Failed to create directory: %s"), *Directory);
+		}
+	}
+
+	TArray<TArray<FAssetVaultCopyResult>> JobResults;
+	JobResults.SetNum(Jobs.Num());
+
+	if (Progress)
+	{
+		Progress->NumJobs += Jobs.Num();
+	}
+
+	std::atomic<int32> NextJob{ 0 };
+	const int32 WorkerCount = FMath::Min(NumWorkers, Jobs.Num());
+
+	ParallelFor(WorkerCount, [this, &Jobs, &JobResults, &NextJob](int32)
+	{
+		for (;;)
+		{
+			if (Progress && Progress->bCancel.load(std::memory_order_relaxed))
+			{
+				break;
+			}
+
+			const int32 JobIndex = NextJob.fetch_add(1);
+			if (JobIndex >= Jobs.Num())
+			{
+				break;
+			}
+			RunJob(Jobs[JobIndex], JobResults[JobIndex]);
+
+			if (Progress)
+			{
+				int64 JobBytes = 0;
+				for (const FAssetVaultCopyResult& Result : JobResults[JobIndex])
+				{
+					JobBytes += Result.BytesCopied;
+				}
+				Progress->BytesCopied += JobBytes;
+				++Progress->JobsDone;
+			}
+		}
+	}, EParallelForFlags::Unbalanced);
+
+	for (TArray<FAssetVaultCopyResult>& Results : JobResults)
+	{
+		for (FAssetVaultCopyResult& Result : Results)
+		{
+			switch (Result.Status)
+			{
+			case EAssetVaultCopyStatus::Copied:
+				++Report.NumCopied;
+				Report.TotalBytes += Result.BytesCopied;
+				++Report.NumByStrategy[static_cast<int32>(Result.Strategy)];
+				ASSETVAULT_COUNT(FilesCopied, 1);
+				ASSETVAULT_COUNT_BYTES(BytesCopied, Result.BytesCopied);
+				break;
+			case EAssetVaultCopyStatus::Failed:
+				++Report.NumFailed;
+				break;
+			case EAssetVaultCopyStatus::Missing:
+				++Report.NumMissing;
+				break;
+			case EAssetVaultCopyStatus::Unchanged:
+				++Report.NumUnchanged;
+				ASSETVAULT_COUNT(FilesUnchanged, 1);
+				break;
+			}
+			Report.Results.Add(MoveTemp(Result));
+		}
+	}
+
+	Report.bCancelled = Progress && Progress->bCancel.load();
+	Report.Seconds = FPlatformTime::Seconds() - StartTime;
+	return Report;
+}
+
+void FAssetVaultCopyEngine::RunJob(const FAssetVaultCopyJob& Job, TArray<FAssetVaultCopyResult>& OutResults) const
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	if (!Job.bPackageFileSet)
+	{
+		CopyOne(Job.SourcePath, Job.TargetPath, PlatformFile.GetStatData(*Job.SourcePath), OutResults.AddDefaulted_GetRef());
+		return;
+	}
+
+	const TArray<FString>& Extensions = GetPackageExtensions();
+	bool bFoundMainFile = false;
+
+	for (int32 ExtIndex = 0; ExtIndex < Extensions.Num(); ++ExtIndex)
+	{
+		const bool bMainExtension = ExtIndex < 2;
+		if (bMainExtension && bFoundMainFile)
+		{
+			continue;
+		}
+
+		const FString SourceFile = Job.SourcePath + Extensions[ExtIndex];
+		const FFileStatData SourceStat = PlatformFile.GetStatData(*SourceFile);
+		if (!SourceStat.bIsValid || SourceStat.bIsDirectory)
+		{
+			continue;
+		}
+
+		bFoundMainFile |= bMainExtension;
+		CopyOne(SourceFile, Job.TargetPath + Extensions[ExtIndex], SourceStat, OutResults.AddDefaulted_GetRef());
+	}
+
+	if (!bFoundMainFile)
+	{
+		FAssetVaultCopyResult& Missing = OutResults.AddDefaulted_GetRef();
+		Missing.SourceFile = Job.SourcePath + Extensions[0];
+		Missing.TargetFile = Job.TargetPath + Extensions[0];
+		Missing.Status = EAssetVaultCopyStatus::Missing;
+	}
+}
+
+void FAssetVaultCopyEngine::CopyOne(const FString& SourceFile, const FString& TargetFile, const FFileStatData& SourceStat, FAssetVaultCopyResult& Result) const
+{
+	Result.SourceFile = SourceFile;
+	Result.TargetFile = TargetFile;
+
+	if (!SourceStat.bIsValid)
+	{
+		Result.Status = EAssetVaultCopyStatus::Failed;
+		return;
+	}
+
+	Result.FileSize = SourceStat.FileSize;
+	Result.SourceTimestamp = SourceStat.ModificationTime;
+
+	if (PreviousFiles)
+	{
+		const FAssetVaultFileEntry* Previous = PreviousFiles->Find(TargetFile);
+		if (Previous && IsUpToDate(*Previous, TargetFile, SourceStat, Result))
+		{
+			Result.Status = EAssetVaultCopyStatus::Unchanged;
+			return;
+		}
+	}
+
+	if (ArchiveWriter)
+	{
+		Result.Status = ArchiveWriter->AddFile(SourceFile, TargetFile, SourceStat, Result.ContentHash);
+	}
+	else if (BlobStore)
+	{
+		Result.Status = BlobStore->Store(SourceFile, SourceStat.FileSize, bUseFileClones, Result.ContentHash, Result.Strategy);
+	}
+	else if (PreviousFiles)
+	{
+		Result.Status = FAssetVaultFileHash::CopyFileAndHash(SourceFile, TargetFile, Result.ContentHash)
+			? EAssetVaultCopyStatus::Copied
+			: EAssetVaultCopyStatus::Failed;
+	}
+	else
+	{
+		Result.Status = FAssetVaultFileCopy::Copy(SourceFile, TargetFile, bUseFileClones, false, Result.Strategy)
+			? EAssetVaultCopyStatus::Copied
+			: EAssetVaultCopyStatus::Failed;
+	}
+
+	if (Result.Status == EAssetVaultCopyStatus::Copied && Result.Strategy == EAssetVaultCopyStrategy::None)
+	{
+		Result.Strategy = EAssetVaultCopyStrategy::Copy;
+	}
+	Result.BytesCopied = Result.Status == EAssetVaultCopyStatus::Copied ? SourceStat.FileSize : 0;
+}
+
+bool FAssetVaultCopyEngine::IsUpToDate(const FAssetVaultFileEntry& Previous, const FString& TargetFile, const FFileStatData& SourceStat, FAssetVaultCopyResult& Result) const
+{
+	if (Previous.Hash.IsEmpty() || Previous.Size != SourceStat.FileSize)
+	{
+		return false;
+	}
+
+	const bool bTargetPresent = BlobStore
+		? BlobStore->Contains(Previous.Hash, Previous.Size)
+		: FPlatformFileManager::Get().GetPlatformFile().FileSize(*TargetFile) == Previous.Size;
+	if (!bTargetPresent)
+	{
+		return false;
+	}
+
+	// Untouched since the last export: trust the recorded hash without reading the file.
+	if (Previous.SourceTimestamp == SourceStat.ModificationTime)
+	{
+		Result.ContentHash = Previous.Hash;
+		return true;
+	}
+
+	// Touched but possibly identical (resave, source control sync): compare content.
+	FString SourceHash;
+	if (FAssetVaultFileHash::HashFile(Result.SourceFile, SourceHash) && SourceHash == Previous.Hash)
+	{
+		Result.ContentHash = MoveTemp(SourceHash);
+		return true;
+	}
+
+	return false;
+}
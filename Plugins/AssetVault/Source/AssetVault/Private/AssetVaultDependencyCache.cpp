@@ -0,0 +1,191 @@
+#include "AssetVaultDependencyCache.h"
+#include "AssetVaultDependencyScope.h"
+#include "AssetVaultStats.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/SoftObjectPath.h"
+
+FAssetVaultDependencyCache& FAssetVaultDependencyCache::Get()
+{
+	static FAssetVaultDependencyCache Instance;
+	return Instance;
+}
+
+void FAssetVaultDependencyCache::CollectClosure(TConstArrayView<FName> RootPackages, const FAssetVaultDependencyScope& Scope, TSet<FName>& InOutPackages,
+	const std::atomic<bool>* CancelFlag, std::atomic<int32>* PackagesResolved)
+{
+	ASSETVAULT_SCOPE(ResolveClosure);
+
+	// Breadth first, so MaxDepth cuts at the shortest distance from any root.
+	TArray<TPair<FName, int32>> PackagesToProcess;
+	for (const FName& RootPackage : RootPackages)
+	{
+		bool bAlreadyInClosure = false;
+		InOutPackages.Add(RootPackage, &bAlreadyInClosure);
+		if (!bAlreadyInClosure)
+		{
+			PackagesToProcess.Emplace(RootPackage, 0);
+		}
+	}
+
+	const bool bNeedAssetClass = Scope.HasClassFilter();
+
+	for (int32 Next = 0; Next < PackagesToProcess.Num(); ++Next)
+	{
+		if (CancelFlag && CancelFlag->load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		const FName PackageName = PackagesToProcess[Next].Key;
+		const int32 Depth = PackagesToProcess[Next].Value;
+		if (PackagesResolved)
+		{
+			++*PackagesResolved;
+		}
+
+		if (Scope.MaxDepth > 0 && Depth >= Scope.MaxDepth)
+		{
+			continue;
+		}
+
+		const FEntry Entry = GetEntry(PackageName, false);
+
+		auto Visit = [&](const TArray<FName>& Dependencies)
+		{
+			for (const FName& Dependency : Dependencies)
+			{
+				if (InOutPackages.Contains(Dependency) || !Scope.IsPackageInScope(Dependency))
+				{
+					continue;
+				}
+				if (bNeedAssetClass)
+				{
+					const FEntry DependencyEntry = GetEntry(Dependency, true);
+					if (Scope.ExcludedClasses.Contains(DependencyEntry.AssetClass))
+					{
+						continue;
+					}
+				}
+				InOutPackages.Add(Dependency);
+				PackagesToProcess.Emplace(Dependency, Depth + 1);
+			}
+		};
+
+		Visit(Entry.Hard);
+		if (Scope.bFollowSoftReferences)
+		{
+			Visit(Entry.Soft);
+		}
+	}
+}
+
+void FAssetVaultDependencyCache::GetDependencies(FName PackageName, TArray<FName>& OutDependencies)
+{
+	OutDependencies.Append(GetEntry(PackageName, false).Hard);
+}
+
+FAssetVaultDependencyCache::FEntry FAssetVaultDependencyCache::GetEntry(FName PackageName, bool bNeedAssetClass)
+{
+	{
+		FReadScopeLock ReadLock(Lock);
+		const FEntry* Cached = Entries.Find(PackageName);
+		if (Cached && (!bNeedAssetClass || Cached->bAssetClassKnown))
+		{
+			++NumHits;
+			ASSETVAULT_COUNT(CacheHits, 1);
+			return *Cached;
+		}
+	}
+
+	++NumMisses;
+	ASSETVAULT_COUNT(CacheMisses, 1);
+
+	// Runs on export workers: the module is loaded by BindToAssetRegistry, only the instance is looked up here.
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	FEntry Entry;
+	TArray<FAssetDependency> Dependencies;
+	AssetRegistry.GetDependencies(FAssetIdentifier(PackageName), Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+	for (const FAssetDependency& Dependency : Dependencies)
+	{
+		if (EnumHasAnyFlags(Dependency.Properties, UE::AssetRegistry::EDependencyProperty::Hard))
+		{
+			Entry.Hard.AddUnique(Dependency.AssetId.PackageName);
+		}
+		else
+		{
+			Entry.Soft.AddUnique(Dependency.AssetId.PackageName);
+		}
+	}
+
+	if (bNeedAssetClass)
+	{
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssetsByPackageName(PackageName, Assets, true);
+		for (const FAssetData& Asset : Assets)
+		{
+			// The main asset shares the package's short name; fall back to the first asset otherwise.
+			if (!Entry.bAssetClassKnown || Asset.AssetName == FPackageName::GetShortFName(PackageName))
+			{
+				Entry.AssetClass = Asset.AssetClassPath;
+				Entry.bAssetClassKnown = true;
+			}
+		}
+		Entry.bAssetClassKnown = true;
+	}
+
+	FWriteScopeLock WriteLock(Lock);
+	Entries.Add(PackageName, Entry);
+	return Entry;
+}
+
+void FAssetVaultDependencyCache::Invalidate(FName PackageName)
+{
+	FWriteScopeLock WriteLock(Lock);
+	Entries.Remove(PackageName);
+}
+
+void FAssetVaultDependencyCache::Reset()
+{
+	FWriteScopeLock WriteLock(Lock);
+	Entries.Reset();
+}
+
+void FAssetVaultDependencyCache::BindToAssetRegistry()
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FAssetVaultDependencyCache::HandleAssetChanged);
+	UpdatedHandle = AssetRegistry.OnAssetUpdated().AddRaw(this, &FAssetVaultDependencyCache::HandleAssetChanged);
+	UpdatedOnDiskHandle = AssetRegistry.OnAssetUpdatedOnDisk().AddRaw(this, &FAssetVaultDependencyCache::HandleAssetChanged);
+	RemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FAssetVaultDependencyCache::HandleAssetChanged);
+	RenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FAssetVaultDependencyCache::HandleAssetRenamed);
+}
+
+void FAssetVaultDependencyCache::UnbindFromAssetRegistry()
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().Remove(AddedHandle);
+		AssetRegistry.OnAssetUpdated().Remove(UpdatedHandle);
+		AssetRegistry.OnAssetUpdatedOnDisk().Remove(UpdatedOnDiskHandle);
+		AssetRegistry.OnAssetRemoved().Remove(RemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(RenamedHandle);
+	}
+	Reset();
+}
+
+void FAssetVaultDependencyCache::HandleAssetChanged(const FAssetData& AssetData)
+{
+	Invalidate(AssetData.PackageName);
+}
+
+void FAssetVaultDependencyCache::HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	Invalidate(AssetData.PackageName);
+	Invalidate(FSoftObjectPath(OldObjectPath).GetLongPackageFName());
+}
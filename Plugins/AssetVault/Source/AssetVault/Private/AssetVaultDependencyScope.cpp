@@ -0,0 +1,97 @@
+#include "AssetVaultDependencyScope.h"
+#include "AssetVaultSettings.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/PackageName.h"
+
+namespace AssetVaultDependencyScope
+{
+	static void AddMountPoints(const TArray<FString>& MountPoints, TArray<FString>& OutPrefixes)
+	{
+		for (FString MountPoint : MountPoints)
+		{
+			MountPoint.TrimStartAndEndInline();
+			if (MountPoint.IsEmpty())
+			{
+				continue;
+			}
+			if (!MountPoint.StartsWith(TEXT("/")))
+			{
+				MountPoint.InsertAt(0, TEXT('/'));
+			}
+			if (!MountPoint.EndsWith(TEXT("/")))
+			{
+				MountPoint.AppendChar(TEXT('/'));
+			}
+			OutPrefixes.Add(MoveTemp(MountPoint));
+		}
+	}
+
+	static bool StartsWithAny(const FString& PackageName, const TArray<FString>& Prefixes)
+	{
+		for (const FString& Prefix : Prefixes)
+		{
+			if (PackageName.StartsWith(Prefix))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+FAssetVaultDependencyScope FAssetVaultDependencyScope::FromSettings()
+{
+	const UAssetVaultSettings* Settings = GetDefault<UAssetVaultSettings>();
+
+	FAssetVaultDependencyScope Scope;
+	AssetVaultDependencyScope::AddMountPoints(Settings->IncludedMountPoints, Scope.IncludedMountPoints);
+	AssetVaultDependencyScope::AddMountPoints(Settings->ExcludedMountPoints, Scope.ExcludedMountPoints);
+	Scope.ExcludedPaths = Settings->ExcludedPaths;
+	Scope.MaxDepth = Settings->MaxDependencyDepth;
+	Scope.bFollowSoftReferences = Settings->bFollowSoftReferences;
+
+	if (Settings->ExcludedClasses.Num() > 0)
+	{
+		TArray<FTopLevelAssetPath> BaseClasses;
+		for (const FSoftClassPath& ClassPath : Settings->ExcludedClasses)
+		{
+			if (ClassPath.IsValid())
+			{
+				BaseClasses.Add(ClassPath.GetAssetPath());
+			}
+		}
+
+		IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+		AssetRegistry.GetDerivedClassNames(BaseClasses, TSet<FTopLevelAssetPath>(), Scope.ExcludedClasses);
+		Scope.ExcludedClasses.Append(BaseClasses);
+	}
+
+	return Scope;
+}
+
+bool FAssetVaultDependencyScope::IsPackageInScope(FName PackageName) const
+{
+	const FString PackageNameStr = PackageName.ToString();
+
+	if (FPackageName::IsScriptPackage(PackageNameStr))
+	{
+		return false;
+	}
+	if (IncludedMountPoints.Num() > 0 && !AssetVaultDependencyScope::StartsWithAny(PackageNameStr, IncludedMountPoints))
+	{
+		return false;
+	}
+	if (AssetVaultDependencyScope::StartsWithAny(PackageNameStr, ExcludedMountPoints))
+	{
+		return false;
+	}
+	for (const FString& Pattern : ExcludedPaths)
+	{
+		if (PackageNameStr.MatchesWildcard(Pattern))
+		{
+			return false;
+		}
+	}
+	return true;
+}
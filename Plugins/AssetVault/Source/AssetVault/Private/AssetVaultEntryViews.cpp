@@ -0,0 +1,170 @@
+#include "AssetVaultEntryViews.h"
+#include "AssetVaultSearchIndex.h"
+
+namespace AssetVaultEntryViews
+{
+	constexpr int32 NumAssetTypes = static_cast<int32>(EAssetType::Other) + 1;
+}
+
+void FAssetVaultEntryView::GetPage(int32 PageIndex, int32 PageSize, TArray<int32>& OutHandles) const
+{
+	OutHandles.Reset();
+
+	const int64 First = static_cast<int64>(FMath::Max(PageIndex, 0)) * FMath::Max(PageSize, 0);
+	if (First >= Num())
+	{
+		return;
+	}
+
+	const int32 Last = static_cast<int32>(FMath::Min<int64>(First + PageSize, Num()));
+	OutHandles.Reserve(Last - static_cast<int32>(First));
+	for (int32 Position = static_cast<int32>(First); Position < Last; ++Position)
+	{
+		OutHandles.Add((*this)[Position]);
+	}
+}
+
+uint64 FAssetVaultEntryViews::PackVersion(const FString& Version)
+{
+	uint64 Packed = 0;
+	int32 Component = 0;
+	uint32 Value = 0;
+
+	for (const TCHAR Char : Version)
+	{
+		if (FChar::IsDigit(Char))
+		{
+			Value = FMath::Min<uint32>(Value * 10 + (Char - TEXT('0')), MAX_uint16);
+		}
+		else if (Char == TEXT('.') && Component < 3)
+		{
+			Packed |= static_cast<uint64>(Value) << (48 - Component * 16);
+			++Component;
+			Value = 0;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	return Packed | (static_cast<uint64>(Value) << (48 - Component * 16));
+}
+
+void FAssetVaultEntryViews::Reset()
+{
+	for (FSortOrder& Order : Orders)
+	{
+		Order = FSortOrder();
+	}
+	ByName.Reset();
+	bNameOrderBuilt = false;
+}
+
+void FAssetVaultEntryViews::UpdateNameOrder(const FAssetVaultSearchIndex& Index)
+{
+	if (bNameOrderBuilt && NameOrderRevision == Index.GetRevision())
+	{
+		return;
+	}
+
+	ByName.Reset(Index.Num());
+	for (int32 Handle = 0; Handle < Index.GetMaxHandle(); ++Handle)
+	{
+		if (Index.IsValidHandle(Handle))
+		{
+			ByName.Add(Handle);
+		}
+	}
+
+	// The only string comparisons, every other order compares integers.
+	ByName.Sort([&Index](int32 A, int32 B)
+	{
+		const int32 NameOrder = Index.GetEntry(A).MainInfo.Name.Compare(Index.GetEntry(B).MainInfo.Name, ESearchCase::IgnoreCase);
+		return NameOrder != 0 ? NameOrder < 0 : Index.GetKey(A) < Index.GetKey(B);
+	});
+
+	NameOrderRevision = Index.GetRevision();
+	bNameOrderBuilt = true;
+}
+
+void FAssetVaultEntryViews::Build(const FAssetVaultSearchIndex& Index, EAssetVaultSortKey SortKey, FSortOrder& Order) const
+{
+	// Primary key per handle, ties keep their name order.
+	TArray<uint64> Keys;
+	Keys.SetNumZeroed(Index.GetMaxHandle());
+	for (const int32 Handle : ByName)
+	{
+		const FAssetMainInfo& MainInfo = Index.GetEntry(Handle).MainInfo;
+		switch (SortKey)
+		{
+		case EAssetVaultSortKey::Name:
+			break;
+		case EAssetVaultSortKey::AssetType:
+			Keys[Handle] = static_cast<uint64>(MainInfo.AssetType);
+			break;
+		case EAssetVaultSortKey::EngineVersion:
+			Keys[Handle] = PackVersion(MainInfo.EngineVersion);
+			break;
+		case EAssetVaultSortKey::Version:
+			Keys[Handle] = PackVersion(MainInfo.Version);
+			break;
+		case EAssetVaultSortKey::Date:
+			Keys[Handle] = static_cast<uint64>(Index.GetTimestamp(Handle).GetTicks());
+			break;
+		}
+	}
+
+	Order.All = ByName;
+	if (SortKey != EAssetVaultSortKey::Name)
+	{
+		Order.All.StableSort([&Keys](int32 A, int32 B) { return Keys[A] < Keys[B]; });
+	}
+
+	// Counting sort by type keeps the order inside each group.
+	Order.TypeStarts.Reset();
+	Order.TypeStarts.SetNumZeroed(AssetVaultEntryViews::NumAssetTypes + 1);
+	for (const int32 Handle : Order.All)
+	{
+		++Order.TypeStarts[static_cast<int32>(Index.GetEntry(Handle).MainInfo.AssetType) + 1];
+	}
+	for (int32 Type = 1; Type < Order.TypeStarts.Num(); ++Type)
+	{
+		Order.TypeStarts[Type] += Order.TypeStarts[Type - 1];
+	}
+
+	TArray<int32> Cursor(Order.TypeStarts.GetData(), AssetVaultEntryViews::NumAssetTypes);
+	Order.ByType.SetNumUninitialized(Order.All.Num());
+	for (const int32 Handle : Order.All)
+	{
+		Order.ByType[Cursor[static_cast<int32>(Index.GetEntry(Handle).MainInfo.AssetType)]++] = Handle;
+	}
+
+	Order.Revision = Index.GetRevision();
+	Order.bBuilt = true;
+}
+
+FAssetVaultEntryView FAssetVaultEntryViews::GetView(const FAssetVaultSearchIndex& Index, EAssetType FilterType, EAssetVaultSortKey SortKey, bool bDescending)
+{
+	FSortOrder& Order = Orders[static_cast<int32>(SortKey)];
+	if (!Order.bBuilt || Order.Revision != Index.GetRevision())
+	{
+		UpdateNameOrder(Index);
+		Build(Index, SortKey, Order);
+	}
+
+	FAssetVaultEntryView View;
+	View.bDescending = bDescending;
+
+	if (FilterType == EAssetType::All)
+	{
+		View.Handles = Order.All;
+	}
+	else
+	{
+		const int32 Type = static_cast<int32>(FilterType);
+		View.Handles = TConstArrayView<int32>(Order.ByType.GetData() + Order.TypeStarts[Type], Order.TypeStarts[Type + 1] - Order.TypeStarts[Type]);
+	}
+
+	return View;
+}
@@ -0,0 +1,193 @@
+#include "AssetVaultFileCopy.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+
+#if PLATFORM_LINUX
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Older sysroots lack the definition, the ioctl itself exists since Linux 4.5.
+#ifndef FICLONE
+#define FICLONE _IOW(0x94, 9, int)
+#endif
+#endif
+
+namespace AssetVaultFileCopy
+{
+#if PLATFORM_LINUX
+	enum class EResult : uint8
+	{
+		Done,
+		// Nothing was written, another strategy can be tried.
+		Unsupported,
+		Failed
+	};
+
+	static bool IsUnsupportedError(int Error)
+	{
+		return Error == EXDEV || Error == ENOSYS || Error == EOPNOTSUPP || Error == ENOTTY || Error == EINVAL || Error == EPERM;
+	}
+
+	static EResult CloneOrCopyRange(const FString& SourceFile, const FString& TargetFile, EAssetVaultCopyStrategy& OutStrategy)
+	{
+		const int SourceFd = open(TCHAR_TO_UTF8(*SourceFile), O_RDONLY | O_CLOEXEC);
+		if (SourceFd < 0)
+		{
+			return EResult::Failed;
+		}
+
+		struct stat SourceStat;
+		const int TargetFd = fstat(SourceFd, &SourceStat) == 0
+			? open(TCHAR_TO_UTF8(*TargetFile), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)
+			: -1;
+		if (TargetFd < 0)
+		{
+			close(SourceFd);
+			return EResult::Failed;
+		}
+
+		EResult Result = EResult::Unsupported;
+		if (ioctl(TargetFd, FICLONE, SourceFd) == 0)
+		{
+			OutStrategy = EAssetVaultCopyStrategy::Clone;
+			Result = EResult::Done;
+		}
+		else if (!IsUnsupportedError(errno))
+		{
+			Result = EResult::Failed;
+		}
+#if defined(SYS_copy_file_range)
+		else
+		{
+			// On file systems with reflink support the kernel clones here as well, elsewhere it
+			// at least copies without bouncing the data through user space.
+			int64 Remaining = SourceStat.st_size;
+			Result = EResult::Done;
+			while (Remaining > 0)
+			{
+				const ssize_t Copied = syscall(SYS_copy_file_range, SourceFd, nullptr, TargetFd, nullptr, static_cast<size_t>(Remaining), 0u);
+				if (Copied <= 0)
+				{
+					const bool bNothingWritten = Remaining == SourceStat.st_size;
+					Result = Copied < 0 && bNothingWritten && IsUnsupportedError(errno) ? EResult::Unsupported : EResult::Failed;
+					break;
+				}
+				Remaining -= Copied;
+			}
+			if (Result == EResult::Done)
+			{
+				OutStrategy = EAssetVaultCopyStrategy::CopyRange;
+			}
+		}
+#endif
+
+		close(SourceFd);
+		if (close(TargetFd) != 0 && Result == EResult::Done)
+		{
+			Result = EResult::Failed;
+		}
+		return Result;
+	}
+#endif
+
+	// TargetFile must not exist yet.
+	static bool CopyToNewFile(const FString& SourceFile, const FString& TargetFile, bool bAllowClone, bool bAllowHardlink, EAssetVaultCopyStrategy& OutStrategy)
+	{
+#if PLATFORM_LINUX
+		const FString FullSource = FPaths::ConvertRelativePathToFull(SourceFile);
+		const FString FullTarget = FPaths::ConvertRelativePathToFull(TargetFile);
+
+		if (bAllowHardlink && link(TCHAR_TO_UTF8(*FullSource), TCHAR_TO_UTF8(*FullTarget)) == 0)
+		{
+			OutStrategy = EAssetVaultCopyStrategy::Hardlink;
+			return true;
+		}
+
+		if (bAllowClone)
+		{
+			switch (CloneOrCopyRange(FullSource, FullTarget, OutStrategy))
+			{
+			case EResult::Done:
+				return true;
+			case EResult::Failed:
+				return false;
+			case EResult::Unsupported:
+				break;
+			}
+		}
+#endif
+
+		if (!FPlatformFileManager::Get().GetPlatformFile().CopyFile(*TargetFile, *SourceFile))
+		{
+			return false;
+		}
+		OutStrategy = EAssetVaultCopyStrategy::Copy;
+		return true;
+	}
+}
+
+bool FAssetVaultFileCopy::Copy(const FString& SourceFile, const FString& TargetFile, bool bAllowClone, bool bAllowHardlink, EAssetVaultCopyStrategy& OutStrategy)
+{
+	OutStrategy = EAssetVaultCopyStrategy::None;
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	// The content goes to a unique name next to the target first and only replaces it once complete,
+	// so an unreadable source or a full disk never costs the existing target.
+	const FString TempFile = MakeTempPath(TargetFile);
+	EAssetVaultCopyStrategy Strategy = EAssetVaultCopyStrategy::None;
+	if (!AssetVaultFileCopy::CopyToNewFile(SourceFile, TempFile, bAllowClone, bAllowHardlink, Strategy))
+	{
+		PlatformFile.DeleteFile(*TempFile);
+		return false;
+	}
+
+	if (!ReplaceFile(TempFile, TargetFile))
+	{
+		return false;
+	}
+
+	OutStrategy = Strategy;
+	return true;
+}
+
+FString FAssetVaultFileCopy::MakeTempPath(const FString& TargetFile)
+{
+	return TargetFile + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+}
+
+bool FAssetVaultFileCopy::ReplaceFile(const FString& TempFile, const FString& TargetFile)
+{
+#if PLATFORM_LINUX
+	// rename() swaps the name atomically and never touches the old target's inode, which may be a
+	// read-only vault blob hard linked into the project. Clearing its read-only flag would unprotect the blob.
+	const bool bReplaced = rename(TCHAR_TO_UTF8(*FPaths::ConvertRelativePathToFull(TempFile)), TCHAR_TO_UTF8(*FPaths::ConvertRelativePathToFull(TargetFile))) == 0;
+#else
+	// A read-only target is replaced like IFileManager::Copy does.
+	const bool bReplaced = IFileManager::Get().Move(*TargetFile, *TempFile, true, true);
+#endif
+	if (!bReplaced)
+	{
+		FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*TempFile);
+	}
+	return bReplaced;
+}
+
+const TCHAR* FAssetVaultFileCopy::GetStrategyName(EAssetVaultCopyStrategy Strategy)
+{
+	switch (Strategy)
+	{
+	case EAssetVaultCopyStrategy::Copy:			return TEXT("copied");
+	case EAssetVaultCopyStrategy::Clone:		return TEXT("cloned");
+	case EAssetVaultCopyStrategy::CopyRange:	return TEXT("kernel-copied");
+	case EAssetVaultCopyStrategy::Hardlink:		return TEXT("hardlinked");
+	default:									return TEXT("none");
+	}
+}
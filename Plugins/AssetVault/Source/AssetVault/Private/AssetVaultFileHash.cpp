@@ -0,0 +1,69 @@
+#include "AssetVaultFileHash.h"
+#include "AssetVaultStats.h"
+
+#include "Hash/Blake3.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Templates/UniquePtr.h"
+
+namespace AssetVaultFileHash
+{
+	constexpr int64 BufferSize = 1024 * 1024;
+
+	// Reads the whole handle through the hasher, optionally mirroring every chunk into Writer.
+	static bool StreamFile(IFileHandle& Reader, IFileHandle* Writer, FString& OutHash)
+	{
+		TArray<uint8> Buffer;
+		Buffer.SetNumUninitialized(BufferSize);
+
+		FBlake3 Hasher;
+		int64 Remaining = Reader.Size();
+		while (Remaining > 0)
+		{
+			const int64 ChunkSize = FMath::Min(Remaining, BufferSize);
+			if (!Reader.Read(Buffer.GetData(), ChunkSize))
+			{
+				return false;
+			}
+			if (Writer && !Writer->Write(Buffer.GetData(), ChunkSize))
+			{
+				return false;
+			}
+			Hasher.Update(Buffer.GetData(), ChunkSize);
+			Remaining -= ChunkSize;
+		}
+
+		ASSETVAULT_COUNT(FilesHashed, 1);
+		const FBlake3Hash Hash = Hasher.Finalize();
+		OutHash = BytesToHex(Hash.GetBytes(), sizeof(FBlake3Hash::ByteArray)).ToLower();
+		return true;
+	}
+}
+
+bool FAssetVaultFileHash::HashFile(const FString& FilePath, FString& OutHash)
+{
+	TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+	return Handle && AssetVaultFileHash::StreamFile(*Handle, nullptr, OutHash);
+}
+
+bool FAssetVaultFileHash::CopyFileAndHash(const FString& SourceFile, const FString& TargetFile, FString& OutHash)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	TUniquePtr<IFileHandle> Reader(PlatformFile.OpenRead(*SourceFile));
+	if (!Reader)
+	{
+		return false;
+	}
+
+	bool bSuccess = false;
+	{
+		TUniquePtr<IFileHandle> Writer(PlatformFile.OpenWrite(*TargetFile));
+		bSuccess = Writer && AssetVaultFileHash::StreamFile(*Reader, Writer.Get(), OutHash) && Writer->Flush();
+	}
+
+	if (!bSuccess)
+	{
+		PlatformFile.DeleteFile(*TargetFile);
+	}
+	return bSuccess;
+}
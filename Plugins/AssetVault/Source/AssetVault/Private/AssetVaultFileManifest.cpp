@@ -0,0 +1,180 @@
+#include "AssetVaultFileManifest.h"
+#include "AssetVaultBlobStore.h"
+#include "AssetVaultCopyEngine.h"
+
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+const TCHAR* FAssetVaultFileManifest::FileName = TEXT("AssetVault.avfiles");
+
+FString FAssetVaultFileManifest::GetSourcePath(const FString& ExportFolder, const FAssetVaultFileEntry& Entry) const
+{
+	if (IsBlobBacked())
+	{
+		FString BlobPath = FAssetVaultBlobStore::GetBlobPath(FPaths::Combine(ExportFolder, BlobRoot), Entry.Hash);
+		FPaths::CollapseRelativeDirectories(BlobPath);
+		return BlobPath;
+	}
+	return FPaths::Combine(ExportFolder, Entry.RelativePath);
+}
+
+void FAssetVaultFileManifest::AddCopyResults(const FString& ExportFolder, const FAssetVaultCopyReport& Report)
+{
+	const FString FolderPrefix = ExportFolder + TEXT("/");
+
+	TSet<FString> SeenPaths;
+	for (const FAssetVaultFileEntry& Entry : Files)
+	{
+		SeenPaths.Add(Entry.RelativePath);
+	}
+
+	for (const FAssetVaultCopyResult& Result : Report.Results)
+	{
+		if (Result.ContentHash.IsEmpty())
+		{
+			continue;
+		}
+
+		FString RelativePath = Result.TargetFile;
+		FPaths::MakePathRelativeTo(RelativePath, *FolderPrefix);
+
+		bool bAlreadySeen = false;
+		SeenPaths.Add(RelativePath, &bAlreadySeen);
+		if (!bAlreadySeen)
+		{
+			Files.Add({ RelativePath, Result.FileSize, Result.SourceTimestamp, Result.ContentHash });
+		}
+	}
+}
+
+FAssetVaultExportDelta FAssetVaultFileManifest::Diff(const FAssetVaultFileManifest& Previous) const
+{
+	TMap<FString, const FAssetVaultFileEntry*> PreviousByPath;
+	PreviousByPath.Reserve(Previous.Files.Num());
+	for (const FAssetVaultFileEntry& Entry : Previous.Files)
+	{
+		PreviousByPath.Add(Entry.RelativePath, &Entry);
+	}
+
+	FAssetVaultExportDelta Delta;
+	for (const FAssetVaultFileEntry& Entry : Files)
+	{
+		const FAssetVaultFileEntry* PreviousEntry = nullptr;
+		if (!PreviousByPath.RemoveAndCopyValue(Entry.RelativePath, PreviousEntry))
+		{
+			++Delta.NumAdded;
+		}
+		else if (PreviousEntry->Hash == Entry.Hash)
+		{
+			++Delta.NumUnchanged;
+		}
+		else
+		{
+			++Delta.NumUpdated;
+		}
+	}
+
+	PreviousByPath.GenerateKeyArray(Delta.RemovedFiles);
+	return Delta;
+}
+
+TMap<FString, FAssetVaultFileEntry> FAssetVaultFileManifest::MakeTargetPathMap(const FString& ExportFolder) const
+{
+	TMap<FString, FAssetVaultFileEntry> Result;
+	Result.Reserve(Files.Num());
+	for (const FAssetVaultFileEntry& Entry : Files)
+	{
+		Result.Add(FPaths::Combine(ExportFolder, Entry.RelativePath), Entry);
+	}
+	return Result;
+}
+
+bool FAssetVaultFileManifest::Exists(const FString& ExportFolder)
+{
+	return FPaths::FileExists(FPaths::Combine(ExportFolder, FileName));
+}
+
+bool FAssetVaultFileManifest::Load(const FString& ExportFolder)
+{
+	BlobRoot.Empty();
+	Files.Empty();
+
+	FString FileContents;
+	if (!FFileHelper::LoadFileToString(FileContents, *FPaths::Combine(ExportFolder, FileName)))
+	{
+		return false;
+	}
+
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FileContents);
+	TSharedPtr<FJsonObject> JsonObject;
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		return false;
+	}
+
+	JsonObject->TryGetStringField(TEXT("BlobRoot"), BlobRoot);
+
+	const TArray<TSharedPtr<FJsonValue>>* FilesArray = nullptr;
+	if (!JsonObject->TryGetArrayField(TEXT("Files"), FilesArray))
+	{
+		return false;
+	}
+
+	Files.Reserve(FilesArray->Num());
+	for (const TSharedPtr<FJsonValue>& Value : *FilesArray)
+	{
+		const TSharedPtr<FJsonObject>* FileObject = nullptr;
+		if (!Value->TryGetObject(FileObject))
+		{
+			continue;
+		}
+
+		FAssetVaultFileEntry& Entry = Files.AddDefaulted_GetRef();
+		(*FileObject)->TryGetStringField(TEXT("Path"), Entry.RelativePath);
+		(*FileObject)->TryGetNumberField(TEXT("Size"), Entry.Size);
+
+		// Ticks do not fit into a JSON double, they are stored as a string.
+		FString TimestampTicks;
+		if ((*FileObject)->TryGetStringField(TEXT("Timestamp"), TimestampTicks))
+		{
+			Entry.SourceTimestamp = FDateTime(FCString::Atoi64(*TimestampTicks));
+		}
+		(*FileObject)->TryGetStringField(TEXT("Hash"), Entry.Hash);
+	}
+
+	return true;
+}
+
+bool FAssetVaultFileManifest::Save(const FString& ExportFolder) const
+{
+	TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	if (IsBlobBacked())
+	{
+		JsonObject->SetStringField(TEXT("BlobRoot"), BlobRoot);
+	}
+
+	TArray<TSharedPtr<FJsonValue>> FilesJson;
+	FilesJson.Reserve(Files.Num());
+	for (const FAssetVaultFileEntry& Entry : Files)
+	{
+		TSharedRef<FJsonObject> FileObject = MakeShared<FJsonObject>();
+		FileObject->SetStringField(TEXT("Path"), Entry.RelativePath);
+		FileObject->SetNumberField(TEXT("Size"), static_cast<double>(Entry.Size));
+		FileObject->SetStringField(TEXT("Timestamp"), LexToString(Entry.SourceTimestamp.GetTicks()));
+		FileObject->SetStringField(TEXT("Hash"), Entry.Hash);
+		FilesJson.Add(MakeShared<FJsonValueObject>(FileObject));
+	}
+	JsonObject->SetArrayField(TEXT("Files"), FilesJson);
+
+	FString OutputString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	if (!FJsonSerializer::Serialize(JsonObject, Writer))
+	{
+		return false;
+	}
+
+	return FFileHelper::SaveStringToFile(OutputString, *FPaths::Combine(ExportFolder, FileName));
+}
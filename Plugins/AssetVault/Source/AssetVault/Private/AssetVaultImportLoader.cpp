@@ -0,0 +1,189 @@
+#include "AssetVaultImportLoader.h"
+#include "AssetVault.h"
+#include "AssetVaultDependencyCache.h"
+#include "AssetVaultStats.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "ContentBrowserModule.h"
+#include "IContentBrowserSingleton.h"
+#include "PackageTools.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+namespace AssetVaultImportLoader
+{
+	struct FLoadBatch
+	{
+		TFunction<void(const TArray<UObject*>&)> OnLoaded;
+		TArray<UObject*> Assets;
+		int32 Pending = 0;
+	};
+
+	static void Visit(int32 Index, const TArray<TArray<int32>>& Dependencies, TArray<uint8>& States, TArray<int32>& OutOrder)
+	{
+		// 0 = unvisited, 1 = on the stack, 2 = emitted.
+		if (States[Index] != 0)
+		{
+			return;
+		}
+		States[Index] = 1;
+		for (int32 Dependency : Dependencies[Index])
+		{
+			Visit(Dependency, Dependencies, States, OutOrder);
+		}
+		States[Index] = 2;
+		OutOrder.Add(Index);
+	}
+}
+
+void FAssetVaultImportLoader::ScanFiles(const TArray<FString>& PackageFiles, bool bForceRescan)
+{
+	ASSETVAULT_SCOPE(RegistryScan);
+
+	if (PackageFiles.Num() == 0)
+	{
+		return;
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.ScanFilesSynchronous(PackageFiles, bForceRescan);
+}
+
+void FAssetVaultImportLoader::SortByDependencies(TArray<FName>& PackageNames)
+{
+	FAssetVaultDependencyCache& DependencyCache = FAssetVaultDependencyCache::Get();
+
+	TMap<FName, int32> Indices;
+	Indices.Reserve(PackageNames.Num());
+	for (int32 Index = 0; Index < PackageNames.Num(); ++Index)
+	{
+		Indices.Add(PackageNames[Index], Index);
+	}
+
+	// Only edges between imported packages matter, everything else is already in the project.
+	TArray<TArray<int32>> Dependencies;
+	Dependencies.SetNum(PackageNames.Num());
+	TArray<FName> PackageDependencies;
+	for (int32 Index = 0; Index < PackageNames.Num(); ++Index)
+	{
+		PackageDependencies.Reset();
+		DependencyCache.GetDependencies(PackageNames[Index], PackageDependencies);
+
+		for (const FName& Dependency : PackageDependencies)
+		{
+			if (const int32* DependencyIndex = Indices.Find(Dependency))
+			{
+				if (*DependencyIndex != Index)
+				{
+					Dependencies[Index].Add(*DependencyIndex);
+				}
+			}
+		}
+	}
+
+	TArray<uint8> States;
+	States.SetNumZeroed(PackageNames.Num());
+	TArray<int32> Order;
+	Order.Reserve(PackageNames.Num());
+	for (int32 Index = 0; Index < PackageNames.Num(); ++Index)
+	{
+		AssetVaultImportLoader::Visit(Index, Dependencies, States, Order);
+	}
+
+	TArray<FName> Sorted;
+	Sorted.Reserve(Order.Num());
+	for (int32 Index : Order)
+	{
+		Sorted.Add(PackageNames[Index]);
+	}
+	PackageNames = MoveTemp(Sorted);
+}
+
+void FAssetVaultImportLoader::SyncContentBrowser(const TArray<FName>& PackageNames)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	FARFilter Filter;
+	Filter.PackageNames = PackageNames;
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	if (Assets.Num() > 0 && !IsRunningCommandlet())
+	{
+		FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
+		ContentBrowserModule.Get().SyncBrowserToAssets(Assets);
+	}
+}
+
+int32 FAssetVaultImportLoader::UnloadResidentPackages(const TArray<FName>& PackageNames)
+{
+	ASSETVAULT_SCOPE(Unload);
+
+	TArray<UPackage*> Resident;
+	for (const FName& PackageName : PackageNames)
+	{
+		if (UPackage* Package = FindPackage(nullptr, *PackageName.ToString()))
+		{
+			Resident.Add(Package);
+		}
+	}
+
+	// UnloadPackages only collects garbage when there is something to unload.
+	if (Resident.Num() > 0)
+	{
+		FText ErrorMessage;
+		if (!UPackageTools::UnloadPackages(Resident, ErrorMessage))
+		{
+			UE_LOG(LogAssetVault, Warning, TEXT("Failed to unload replaced packages: %s"), *ErrorMessage.ToString());
+			return 0;
+		}
+	}
+	return Resident.Num();
+}
+
+void FAssetVaultImportLoader::LoadAsync(const TArray<FName>& PackageNames, TFunction<void(const TArray<UObject*>&)> OnLoaded)
+{
+	ASSETVAULT_SCOPE(Load);
+
+	if (PackageNames.Num() == 0)
+	{
+		if (OnLoaded)
+		{
+			OnLoaded(TArray<UObject*>());
+		}
+		return;
+	}
+
+	TSharedRef<AssetVaultImportLoader::FLoadBatch> Batch = MakeShared<AssetVaultImportLoader::FLoadBatch>();
+	Batch->OnLoaded = MoveTemp(OnLoaded);
+	Batch->Pending = PackageNames.Num();
+
+	for (int32 Index = 0; Index < PackageNames.Num(); ++Index)
+	{
+		LoadPackageAsync(PackageNames[Index].ToString(), FLoadPackageAsyncDelegate::CreateLambda(
+			[Batch](const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type Result)
+			{
+				if (Package && Result == EAsyncLoadingResult::Succeeded)
+				{
+					ForEachObjectWithPackage(Package, [&Batch](UObject* Object)
+					{
+						if (Object->IsAsset())
+						{
+							Batch->Assets.Add(Object);
+						}
+						return true;
+					}, false);
+				}
+				else
+				{
+					UE_LOG(LogAssetVault, Warning, TEXT("Async load failed: %s"), *PackageName.ToString());
+				}
+
+				if (--Batch->Pending == 0 && Batch->OnLoaded)
+				{
+					Batch->OnLoaded(Batch->Assets);
+				}
+			}), PackageNames.Num() - Index);
+	}
+}
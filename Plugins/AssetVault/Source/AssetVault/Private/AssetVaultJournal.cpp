@@ -0,0 +1,145 @@
+#include "AssetVaultJournal.h"
+#include "AssetVault.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace AssetVaultJournal
+{
+	template <typename ElementType>
+	static void AddToRing(TArray<ElementType>& Ring, int32& Next, int32 Capacity, ElementType&& Element)
+	{
+		if (Ring.Num() < Capacity)
+		{
+			Ring.Add(MoveTemp(Element));
+			return;
+		}
+		Ring[Next] = MoveTemp(Element);
+		Next = (Next + 1) % Capacity;
+	}
+
+	// Visits the elements of a ring buffer from oldest to newest.
+	template <typename ElementType, typename FunctionType>
+	static void ForEachInRing(const TArray<ElementType>& Ring, int32 Next, FunctionType&& Function)
+	{
+		for (int32 Offset = 0; Offset < Ring.Num(); ++Offset)
+		{
+			Function(Ring[(Next + Offset) % Ring.Num()]);
+		}
+	}
+
+	static FAutoConsoleCommand DumpCommand(
+		TEXT("AssetVault.DumpJournal"),
+		TEXT("Writes the per-file journal of recent AssetVault operations to JSON. Optional argument: output file."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			const FString FilePath = Args.Num() > 0 ? Args[0] : FPaths::Combine(FPaths::ProjectLogDir(), TEXT("AssetVaultJournal.json"));
+			if (FAssetVaultJournal::Get().DumpToJson(FilePath))
+			{
+				UE_LOG(LogAssetVault, Display, TEXT("Journal written to %s"), *FilePath);
+			}
+		}));
+}
+
+FAssetVaultJournal& FAssetVaultJournal::Get()
+{
+	static FAssetVaultJournal Instance;
+	return Instance;
+}
+
+uint32 FAssetVaultJournal::BeginOperation(const TCHAR* Name, const FString& Context)
+{
+	FScopeLock ScopeLock(&Lock);
+	FOperation Operation{ NextOperationId++, Name, Context, FPlatformTime::Seconds() };
+	const uint32 Id = Operation.Id;
+	AssetVaultJournal::AddToRing(Operations, NextOperation, MaxOperations, MoveTemp(Operation));
+	return Id;
+}
+
+void FAssetVaultJournal::Add(uint32 OperationId, EAssetVaultJournalAction Action, FString Path, int64 Bytes, EAssetVaultCopyStrategy Strategy)
+{
+	FAssetVaultJournalEntry Entry{ FPlatformTime::Seconds(), OperationId, Action, Strategy, Bytes, MoveTemp(Path) };
+
+	FScopeLock ScopeLock(&Lock);
+	AssetVaultJournal::AddToRing(Entries, NextEntry, MaxEntries, MoveTemp(Entry));
+}
+
+bool FAssetVaultJournal::DumpToJson(const FString& FilePath) const
+{
+	TArray<TSharedPtr<FJsonValue>> OperationsJson;
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		AssetVaultJournal::ForEachInRing(Operations, NextOperation, [&](const FOperation& Operation)
+		{
+			TSharedRef<FJsonObject> OperationJson = MakeShared<FJsonObject>();
+			OperationJson->SetNumberField(TEXT("Id"), Operation.Id);
+			OperationJson->SetStringField(TEXT("Name"), Operation.Name);
+			OperationJson->SetStringField(TEXT("Context"), Operation.Context);
+			OperationJson->SetNumberField(TEXT("StartTime"), Operation.StartTime);
+			OperationJson->SetArrayField(TEXT("Entries"), {});
+			OperationsJson.Add(MakeShared<FJsonValueObject>(OperationJson));
+		});
+
+		TMap<uint32, TArray<TSharedPtr<FJsonValue>>> Grouped;
+		AssetVaultJournal::ForEachInRing(Entries, NextEntry, [&](const FAssetVaultJournalEntry& Entry)
+		{
+			TSharedRef<FJsonObject> EntryJson = MakeShared<FJsonObject>();
+			EntryJson->SetNumberField(TEXT("Time"), Entry.Time);
+			EntryJson->SetStringField(TEXT("Action"), GetActionName(Entry.Action));
+			EntryJson->SetStringField(TEXT("Path"), Entry.Path);
+			if (Entry.Bytes > 0)
+			{
+				EntryJson->SetNumberField(TEXT("Bytes"), static_cast<double>(Entry.Bytes));
+			}
+			if (Entry.Strategy != EAssetVaultCopyStrategy::None)
+			{
+				EntryJson->SetStringField(TEXT("Strategy"), FAssetVaultFileCopy::GetStrategyName(Entry.Strategy));
+			}
+			Grouped.FindOrAdd(Entry.OperationId).Add(MakeShared<FJsonValueObject>(EntryJson));
+		});
+
+		for (const TSharedPtr<FJsonValue>& OperationValue : OperationsJson)
+		{
+			const TSharedPtr<FJsonObject>& OperationJson = OperationValue->AsObject();
+			if (TArray<TSharedPtr<FJsonValue>>* OperationEntries = Grouped.Find(static_cast<uint32>(OperationJson->GetNumberField(TEXT("Id")))))
+			{
+				OperationJson->SetArrayField(TEXT("Entries"), MoveTemp(*OperationEntries));
+			}
+		}
+	}
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetArrayField(TEXT("Operations"), OperationsJson);
+
+	FString Json;
+	FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Json));
+	return FFileHelper::SaveStringToFile(Json, *FilePath);
+}
+
+void FAssetVaultJournal::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+	Entries.Reset();
+	Operations.Reset();
+	NextEntry = 0;
+	NextOperation = 0;
+}
+
+const TCHAR* FAssetVaultJournal::GetActionName(EAssetVaultJournalAction Action)
+{
+	switch (Action)
+	{
+	case EAssetVaultJournalAction::Copied:				return TEXT("Copied");
+	case EAssetVaultJournalAction::Replaced:			return TEXT("Replaced");
+	case EAssetVaultJournalAction::SkippedIdentical:	return TEXT("SkippedIdentical");
+	case EAssetVaultJournalAction::SkippedExisting:		return TEXT("SkippedExisting");
+	case EAssetVaultJournalAction::Failed:				return TEXT("Failed");
+	default:											return TEXT("ClosedEditor");
+	}
+}
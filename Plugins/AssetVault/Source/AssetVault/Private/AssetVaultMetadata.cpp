@@ -0,0 +1,378 @@
+#include "AssetVaultMetadata.h"
+#include "AssetVault.h"
+#include "AssetVaultStats.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Serialization/CompactBinary.h"
+#include "Serialization/CompactBinaryValidation.h"
+#include "Serialization/CompactBinaryWriter.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+const TCHAR* FAssetVaultMetadata::BinaryExtension = TEXT("avmeta");
+
+namespace AssetVaultMetadata
+{
+	static void WriteStringArray(FCbWriter& Writer, FUtf8StringView Name, const TArray<FString>& Values)
+	{
+		Writer.BeginArray(Name);
+		for (const FString& Value : Values)
+		{
+			Writer.AddString(Value);
+		}
+		Writer.EndArray();
+	}
+
+	// Writes through a temporary file so readers never see a partial file.
+	static bool ReplaceFile(const FString& FilePath, TFunctionRef<bool(const FString&)> Write)
+	{
+		const FString TempPath = FilePath + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+		if (!Write(TempPath) || !IFileManager::Get().Move(*FilePath, *TempPath, true))
+		{
+			IFileManager::Get().Delete(*TempPath);
+			return false;
+		}
+		return true;
+	}
+
+	static TSharedPtr<FJsonObject> MakeHistoryEntry(const FJsonObject& Metadata, const FDateTime& FileTimestamp)
+	{
+		TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+		for (const TCHAR* Field : { TEXT("Version"), TEXT("VersionComment"), TEXT("EngineVersion") })
+		{
+			Entry->SetStringField(Field, Metadata.GetStringField(Field));
+		}
+
+		FString ExportedAt;
+		if (!Metadata.TryGetStringField(TEXT("ExportedAt"), ExportedAt))
+		{
+			ExportedAt = FileTimestamp.ToIso8601();
+		}
+		Entry->SetStringField(TEXT("ExportedAt"), ExportedAt);
+
+		const TArray<TSharedPtr<FJsonValue>>* Assets = nullptr;
+		Entry->SetNumberField(TEXT("NumAssets"), Metadata.TryGetArrayField(TEXT("Assets"), Assets) ? Assets->Num() : 0);
+		return Entry;
+	}
+
+	static void ReadStringArray(FCbFieldView Field, TArray<FString>& OutValues)
+	{
+		FCbArrayView Array = Field.AsArrayView();
+		OutValues.Reset(static_cast<int32>(Array.Num()));
+		for (FCbFieldView Value : Array)
+		{
+			OutValues.Emplace(Value.AsString());
+		}
+	}
+}
+
+EAssetType StringToAssetType(const FString& AssetTypeStr)
+{
+
+	if (AssetTypeStr.Equals(TEXT("All"), ESearchCase::IgnoreCase))
+		return EAssetType::All;
+	if (AssetTypeStr.Equals(TEXT("Blueprint"), ESearchCase::IgnoreCase))
+		return EAssetType::Blueprint;
+	else if (AssetTypeStr.Equals(TEXT("Material"), ESearchCase::IgnoreCase))
+		return EAssetType::Material;
+	else if (AssetTypeStr.Equals(TEXT("Level"), ESearchCase::IgnoreCase))
+		return EAssetType::Level;
+	else if (AssetTypeStr.Equals(TEXT("Texture"), ESearchCase::IgnoreCase))
+		return EAssetType::Texture;
+	else if (AssetTypeStr.Equals(TEXT("StaticMesh"), ESearchCase::IgnoreCase) || AssetTypeStr.Equals(TEXT("Static Mesh"), ESearchCase::IgnoreCase))
+		return EAssetType::StaticMesh;
+	else if (AssetTypeStr.Equals(TEXT("Sound"), ESearchCase::IgnoreCase))
+		return EAssetType::Sound;
+	else
+		return EAssetType::Other;
+}
+
+bool FAssetVaultMetadata::LoadFromJsonFile(const FString& FilePath, FAssetExportOptions& OutOptions)
+{
+	FString FileContents;
+	if (!FFileHelper::LoadFileToString(FileContents, *FilePath))
+	{
+		UE_LOG(LogAssetVault, Warning, TEXT("Failed to read file: %s"), *FilePath);
+		return false;
+	}
+
+	if (!ParseJson(FileContents, OutOptions))
+	{
+		UE_LOG(LogAssetVault, Warning, TEXT("Failed to parse JSON in file: %s"), *FilePath);
+		return false;
+	}
+	return true;
+}
+
+bool FAssetVaultMetadata::ParseJson(const FString& JsonText, FAssetExportOptions& OutOptions)
+{
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+	TSharedPtr<FJsonObject> JsonObject;
+
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		return false;
+	}
+
+	FAssetExportOptions Options;
+
+	JsonObject->TryGetStringField(TEXT("Name"), Options.MainInfo.Name);
+
+	FString AssetTypeStr;
+	JsonObject->TryGetStringField(TEXT("AssetType"), AssetTypeStr);
+	AssetTypeStr = AssetTypeStr.Replace(TEXT("EAssetType::"), TEXT(""));
+	Options.MainInfo.AssetType = StringToAssetType(AssetTypeStr);
+
+	JsonObject->TryGetStringField(TEXT("Description"), Options.MainInfo.Description);
+	JsonObject->TryGetStringField(TEXT("EngineVersion"), Options.MainInfo.EngineVersion);
+	JsonObject->TryGetStringField(TEXT("CustomFolder"), Options.MainInfo.CustomFolder);
+	JsonObject->TryGetStringField(TEXT("RelativeExportPath"), Options.MainInfo.RelativeExportPath);
+	JsonObject->TryGetStringField(TEXT("VersionComment"), Options.MainInfo.VersionComment);
+
+	if (!JsonObject->TryGetStringField(TEXT("Version"), Options.MainInfo.Version))
+	{
+		Options.MainInfo.Version = TEXT("1.0");
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* TagsArray = nullptr;
+	if (JsonObject->TryGetArrayField(TEXT("Tags"), TagsArray))
+	{
+		for (const TSharedPtr<FJsonValue>& TagValue : *TagsArray)
+		{
+			if (TagValue->Type == EJson::String)
+			{
+				Options.AdditionalInfo.Tags.Add(TagValue->AsString());
+			}
+		}
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* PreviewsArray = nullptr;
+	if (JsonObject->TryGetArrayField(TEXT("PreviewImages"), PreviewsArray))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *PreviewsArray)
+		{
+			if (Value->Type == EJson::String)
+			{
+				Options.AdditionalInfo.PreviewImagePaths.Add(Value->AsString());
+			}
+		}
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* AssetsArray = nullptr;
+	if (JsonObject->TryGetArrayField(TEXT("Assets"), AssetsArray))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *AssetsArray)
+		{
+			if (Value->Type == EJson::String)
+			{
+				Options.MainInfo.ExportedAssetNames.Add(Value->AsString());
+			}
+		}
+	}
+
+	OutOptions = MoveTemp(Options);
+	return true;
+}
+
+FString FAssetVaultMetadata::GetBinaryPath(const FString& JsonFilePath)
+{
+	return FPaths::ChangeExtension(JsonFilePath, BinaryExtension);
+}
+
+bool FAssetVaultMetadata::SaveToBinaryFile(const FString& FilePath, const FAssetExportOptions& Options)
+{
+	const FAssetMainInfo& MainInfo = Options.MainInfo;
+
+	FCbWriter Writer;
+	Writer.BeginObject();
+	Writer.AddInteger(UTF8TEXTVIEW("SchemaVersion"), SchemaVersion);
+	Writer.AddString(UTF8TEXTVIEW("Name"), MainInfo.Name);
+	Writer.AddString(UTF8TEXTVIEW("AssetType"), StaticEnum<EAssetType>()->GetNameStringByValue(static_cast<int64>(MainInfo.AssetType)));
+	Writer.AddString(UTF8TEXTVIEW("Description"), MainInfo.Description);
+	Writer.AddString(UTF8TEXTVIEW("EngineVersion"), MainInfo.EngineVersion);
+	Writer.AddString(UTF8TEXTVIEW("Version"), MainInfo.Version);
+	Writer.AddString(UTF8TEXTVIEW("VersionComment"), MainInfo.VersionComment);
+	Writer.AddString(UTF8TEXTVIEW("CustomFolder"), MainInfo.CustomFolder);
+	Writer.AddString(UTF8TEXTVIEW("RelativeExportPath"), MainInfo.RelativeExportPath);
+	AssetVaultMetadata::WriteStringArray(Writer, UTF8TEXTVIEW("Tags"), Options.AdditionalInfo.Tags);
+	AssetVaultMetadata::WriteStringArray(Writer, UTF8TEXTVIEW("Assets"), MainInfo.ExportedAssetNames);
+	AssetVaultMetadata::WriteStringArray(Writer, UTF8TEXTVIEW("PreviewImages"), Options.AdditionalInfo.PreviewImagePaths);
+	Writer.EndObject();
+
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(static_cast<int32>(Writer.GetSaveSize()));
+	Writer.Save(MakeMemoryView(Buffer));
+
+	return FFileHelper::SaveArrayToFile(Buffer, *FilePath);
+}
+
+bool FAssetVaultMetadata::LoadFromBinaryFile(const FString& FilePath, FAssetExportOptions& OutOptions)
+{
+	// Scans call this from the task workers for every export, each worker keeps its buffer.
+	static thread_local TArray<uint8> Buffer;
+	if (!FFileHelper::LoadFileToArray(Buffer, *FilePath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	const FMemoryView View = MakeMemoryView(Buffer);
+	if (ValidateCompactBinary(View, ECbValidateMode::Default) != ECbValidateError::None)
+	{
+		UE_LOG(LogAssetVault, Warning, TEXT("Invalid metadata sidecar: %s"), *FilePath);
+		return false;
+	}
+
+	const FCbObjectView Object = FCbFieldView(View.GetData()).AsObjectView();
+	if (Object["SchemaVersion"].AsInt32() != SchemaVersion)
+	{
+		return false;
+	}
+
+	FAssetExportOptions Options;
+	FAssetMainInfo& MainInfo = Options.MainInfo;
+
+	// One pass over the fields in write order, instead of a lookup per property.
+	for (FCbFieldView Field : Object)
+	{
+		const FUtf8StringView Name = Field.GetName();
+		if (Name == UTF8TEXTVIEW("Name"))
+		{
+			MainInfo.Name = FString(Field.AsString());
+		}
+		else if (Name == UTF8TEXTVIEW("AssetType"))
+		{
+			MainInfo.AssetType = StringToAssetType(FString(Field.AsString()));
+		}
+		else if (Name == UTF8TEXTVIEW("Description"))
+		{
+			MainInfo.Description = FString(Field.AsString());
+		}
+		else if (Name == UTF8TEXTVIEW("EngineVersion"))
+		{
+			MainInfo.EngineVersion = FString(Field.AsString());
+		}
+		else if (Name == UTF8TEXTVIEW("Version"))
+		{
+			MainInfo.Version = FString(Field.AsString());
+		}
+		else if (Name == UTF8TEXTVIEW("VersionComment"))
+		{
+			MainInfo.VersionComment = FString(Field.AsString());
+		}
+		else if (Name == UTF8TEXTVIEW("CustomFolder"))
+		{
+			MainInfo.CustomFolder = FString(Field.AsString());
+		}
+		else if (Name == UTF8TEXTVIEW("RelativeExportPath"))
+		{
+			MainInfo.RelativeExportPath = FString(Field.AsString());
+		}
+		else if (Name == UTF8TEXTVIEW("Tags"))
+		{
+			AssetVaultMetadata::ReadStringArray(Field, Options.AdditionalInfo.Tags);
+		}
+		else if (Name == UTF8TEXTVIEW("Assets"))
+		{
+			AssetVaultMetadata::ReadStringArray(Field, MainInfo.ExportedAssetNames);
+		}
+		else if (Name == UTF8TEXTVIEW("PreviewImages"))
+		{
+			AssetVaultMetadata::ReadStringArray(Field, Options.AdditionalInfo.PreviewImagePaths);
+		}
+	}
+
+	OutOptions = MoveTemp(Options);
+	return true;
+}
+
+FString FAssetVaultMetadata::MakeFileName(const FString& BaseName, EAssetType AssetType)
+{
+	FString FileName = FString::Printf(TEXT("%s_%s.json"), *BaseName, *StaticEnum<EAssetType>()->GetNameStringByValue(static_cast<int64>(AssetType)));
+	FPaths::MakeValidFileName(FileName);
+	return FileName;
+}
+
+TArray<TSharedPtr<FJsonValue>> FAssetVaultMetadata::CollectHistory(const FString& ExportFolder, int32 MaxEntries)
+{
+	TArray<TSharedPtr<FJsonObject>> Entries;
+
+	TArray<FString> MetadataFiles;
+	IFileManager::Get().FindFiles(MetadataFiles, *FPaths::Combine(ExportFolder, TEXT("*.json")), true, false);
+
+	for (const FString& MetadataFile : MetadataFiles)
+	{
+		const FString FilePath = FPaths::Combine(ExportFolder, MetadataFile);
+
+		FString FileContents;
+		TSharedPtr<FJsonObject> Metadata;
+		if (!FFileHelper::LoadFileToString(FileContents, *FilePath)
+			|| !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(FileContents), Metadata) || !Metadata.IsValid())
+		{
+			continue;
+		}
+
+		Entries.Add(AssetVaultMetadata::MakeHistoryEntry(*Metadata, IFileManager::Get().GetTimeStamp(*FilePath)));
+
+		const TArray<TSharedPtr<FJsonValue>>* History = nullptr;
+		if (Metadata->TryGetArrayField(TEXT("History"), History))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *History)
+			{
+				const TSharedPtr<FJsonObject>* Entry = nullptr;
+				if (Value->TryGetObject(Entry))
+				{
+					Entries.Add(*Entry);
+				}
+			}
+		}
+	}
+
+	// ISO 8601 timestamps sort chronologically as strings.
+	Entries.Sort([](const TSharedPtr<FJsonObject>& A, const TSharedPtr<FJsonObject>& B)
+	{
+		return A->GetStringField(TEXT("ExportedAt")) > B->GetStringField(TEXT("ExportedAt"));
+	});
+
+	TArray<TSharedPtr<FJsonValue>> History;
+	for (int32 Index = 0; Index < FMath::Min(Entries.Num(), MaxEntries); ++Index)
+	{
+		History.Add(MakeShared<FJsonValueObject>(Entries[Index]));
+	}
+	return History;
+}
+
+bool FAssetVaultMetadata::SaveToExportFolder(const FString& ExportFolder, const FString& FileName, const FString& JsonText, const FAssetExportOptions& Options)
+{
+	ASSETVAULT_SCOPE(WriteMetadata);
+
+	const FString MetadataPath = FPaths::Combine(ExportFolder, FileName);
+	if (!AssetVaultMetadata::ReplaceFile(MetadataPath, [&JsonText](const FString& TempPath) { return FFileHelper::SaveStringToFile(JsonText, *TempPath); }))
+	{
+		UE_LOG(LogAssetVault, Error, TEXT("Failed to save metadata to: %s"), *MetadataPath);
+		return false;
+	}
+
+	// Written after the JSON so it is never older than it. A missing sidecar only makes scans fall back to the JSON.
+	const FString BinaryPath = GetBinaryPath(MetadataPath);
+	if (!AssetVaultMetadata::ReplaceFile(BinaryPath, [&Options](const FString& TempPath) { return SaveToBinaryFile(TempPath, Options); }))
+	{
+		UE_LOG(LogAssetVault, Warning, TEXT("Failed to save binary metadata next to: %s"), *MetadataPath);
+		IFileManager::Get().Delete(*BinaryPath);
+	}
+
+	TArray<FString> MetadataFiles;
+	IFileManager::Get().FindFiles(MetadataFiles, *FPaths::Combine(ExportFolder, TEXT("*.json")), true, false);
+	for (const FString& MetadataFile : MetadataFiles)
+	{
+		if (!MetadataFile.Equals(FileName, ESearchCase::IgnoreCase))
+		{
+			const FString StalePath = FPaths::Combine(ExportFolder, MetadataFile);
+			IFileManager::Get().Delete(*StalePath);
+			IFileManager::Get().Delete(*GetBinaryPath(StalePath));
+		}
+	}
+	return true;
+}
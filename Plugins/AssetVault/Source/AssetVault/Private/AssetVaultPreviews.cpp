@@ -0,0 +1,257 @@
+#include "AssetVaultPreviews.h"
+#include "AssetVault.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "ImageUtils.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/ObjectThumbnail.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "ObjectTools.h"
+#include "Serialization/MemoryWriter.h"
+
+const TCHAR* FAssetVaultPreviewFile::FileName = TEXT("AssetVault.avpreview");
+
+namespace AssetVaultPreviews
+{
+	constexpr uint32 Magic = 0x56505641; // "AVPV"
+	constexpr uint32 Version = 2;
+	// Same layout, entries keyed by asset name. Still read, the metadata of such exports lists asset names.
+	constexpr uint32 AssetNameKeyedVersion = 1;
+
+	// Previews that decode to nothing still occupy a slot, so they are charged a little.
+	constexpr int64 MinEntryBytes = 1024;
+
+	struct FTableEntry
+	{
+		FString ObjectPath;
+		int32 Width = 0;
+		int32 Height = 0;
+		// Relative to the end of the table.
+		int64 Offset = 0;
+		int64 Size = 0;
+
+		friend FArchive& operator<<(FArchive& Ar, FTableEntry& Entry)
+		{
+			return Ar << Entry.ObjectPath << Entry.Width << Entry.Height << Entry.Offset << Entry.Size;
+		}
+	};
+
+	static FString MakeKey(const FString& ExportFolder, const FString& ObjectPath)
+	{
+		return ExportFolder / ObjectPath;
+	}
+}
+
+FString FAssetVaultPreviewFile::GetPath(const FString& ExportFolder)
+{
+	return FPaths::Combine(ExportFolder, FileName);
+}
+
+bool FAssetVaultPreviewFile::Write(const FString& ExportFolder, TConstArrayView<FName> PackageNames, TArray<FString>& OutObjectPaths)
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TArray<AssetVaultPreviews::FTableEntry> Table;
+	TArray<uint8> ImageData;
+
+	for (const FName PackageName : PackageNames)
+	{
+		FString PackageFile;
+		if (!FPackageName::DoesPackageExist(PackageName.ToString(), &PackageFile))
+		{
+			continue;
+		}
+
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssetsByPackageName(PackageName, Assets, true);
+
+		TSet<FName> ObjectFullNames;
+		for (const FAssetData& Asset : Assets)
+		{
+			ObjectFullNames.Add(FName(*Asset.GetFullName()));
+		}
+
+		FThumbnailMap Thumbnails;
+		if (ObjectFullNames.IsEmpty() || !ThumbnailTools::LoadThumbnailsFromPackage(PackageFile, ObjectFullNames, Thumbnails))
+		{
+			continue;
+		}
+
+		for (const FAssetData& Asset : Assets)
+		{
+			FObjectThumbnail* Thumbnail = Thumbnails.Find(FName(*Asset.GetFullName()));
+			if (!Thumbnail || Thumbnail->IsEmpty())
+			{
+				continue;
+			}
+
+			AssetVaultPreviews::FTableEntry& Entry = Table.AddDefaulted_GetRef();
+			Entry.ObjectPath = Asset.GetObjectPathString();
+			Entry.Width = Thumbnail->GetImageWidth();
+			Entry.Height = Thumbnail->GetImageHeight();
+			Entry.Offset = ImageData.Num();
+
+			// The compressed image is copied as is. Thumbnails saved uncompressed by old engines are encoded to PNG.
+			const TArray<uint8>& Compressed = Thumbnail->AccessCompressedImageData();
+			if (Compressed.Num() > 0)
+			{
+				ImageData.Append(Compressed);
+			}
+			else
+			{
+				const TArray<uint8>& Raw = Thumbnail->GetUncompressedImageData();
+				TArray64<uint8> Png;
+				FImageUtils::PNGCompressImageArray(Entry.Width, Entry.Height,
+					TArrayView64<const FColor>(reinterpret_cast<const FColor*>(Raw.GetData()), Raw.Num() / sizeof(FColor)), Png);
+				ImageData.Append(Png.GetData(), static_cast<int32>(Png.Num()));
+			}
+
+			Entry.Size = ImageData.Num() - Entry.Offset;
+			OutObjectPaths.Add(Entry.ObjectPath);
+		}
+	}
+
+	const FString PreviewPath = GetPath(ExportFolder);
+	if (Table.IsEmpty())
+	{
+		IFileManager::Get().Delete(*PreviewPath, false, false, true);
+		return true;
+	}
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	uint32 Magic = AssetVaultPreviews::Magic;
+	uint32 Version = AssetVaultPreviews::Version;
+	Writer << Magic << Version << Table;
+	Bytes.Append(ImageData);
+
+	const FString TempPath = PreviewPath + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !IFileManager::Get().Move(*PreviewPath, *TempPath, true))
+	{
+		IFileManager::Get().Delete(*TempPath);
+		UE_LOG(LogAssetVault, Warning, TEXT("Failed to save previews to: %s"), *PreviewPath);
+		return false;
+	}
+	return true;
+}
+
+bool FAssetVaultPreviewFile::ReadImage(const FString& ExportFolder, const FString& ObjectPath, TArray<uint8>& OutImage)
+{
+	// Only the header, the table and the one image are read, the other previews of the export stay on disk.
+	const TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*GetPath(ExportFolder), FILEREAD_Silent));
+	if (!Reader)
+	{
+		return false;
+	}
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	TArray<AssetVaultPreviews::FTableEntry> Table;
+	*Reader << Magic << Version;
+	if (Reader->IsError() || Magic != AssetVaultPreviews::Magic
+		|| (Version != AssetVaultPreviews::Version && Version != AssetVaultPreviews::AssetNameKeyedVersion))
+	{
+		return false;
+	}
+	*Reader << Table;
+
+	const int64 DataOffset = Reader->Tell();
+	const AssetVaultPreviews::FTableEntry* Entry = Table.FindByPredicate([&ObjectPath](const AssetVaultPreviews::FTableEntry& Candidate)
+	{
+		return Candidate.ObjectPath == ObjectPath;
+	});
+	if (Reader->IsError() || !Entry || Entry->Offset < 0 || Entry->Size <= 0 || Entry->Size > MAX_int32
+		|| DataOffset + Entry->Offset + Entry->Size > Reader->TotalSize())
+	{
+		return false;
+	}
+
+	OutImage.SetNumUninitialized(static_cast<int32>(Entry->Size));
+	Reader->Seek(DataOffset + Entry->Offset);
+	Reader->Serialize(OutImage.GetData(), Entry->Size);
+	return !Reader->IsError();
+}
+
+FAssetVaultPreviewCache::FAssetVaultPreviewCache(int64 InBudgetBytes)
+	: BudgetBytes(InBudgetBytes)
+{
+}
+
+UTexture2D* FAssetVaultPreviewCache::Get(const FString& ExportFolder, const FString& ObjectPath)
+{
+	const FString Key = AssetVaultPreviews::MakeKey(ExportFolder, ObjectPath);
+	if (FEntry* Entry = Entries.Find(Key))
+	{
+		UsageOrder.RemoveNode(Entry->Node, false);
+		UsageOrder.AddHead(Entry->Node);
+		return Entry->Texture;
+	}
+
+	UTexture2D* Texture = nullptr;
+	TArray<uint8> Image;
+	if (FAssetVaultPreviewFile::ReadImage(ExportFolder, ObjectPath, Image))
+	{
+		Texture = FImageUtils::ImportBufferAsTexture2D(TArrayView64<const uint8>(Image.GetData(), Image.Num()));
+	}
+
+	FEntry& Entry = Entries.Add(Key);
+	Entry.Texture = Texture;
+	Entry.Bytes = FMath::Max(Texture ? static_cast<int64>(Texture->GetSizeX()) * Texture->GetSizeY() * 4 : 0, AssetVaultPreviews::MinEntryBytes);
+	UsageOrder.AddHead(Key);
+	Entry.Node = UsageOrder.GetHead();
+	UsedBytes += Entry.Bytes;
+
+	// The new entry stays even when it alone exceeds the budget.
+	while (UsedBytes > BudgetBytes && UsageOrder.Num() > 1)
+	{
+		const FString LeastRecentKey = UsageOrder.GetTail()->GetValue();
+		Remove(LeastRecentKey);
+	}
+	return Texture;
+}
+
+void FAssetVaultPreviewCache::Invalidate(const FString& ExportFolder)
+{
+	const FString Prefix = ExportFolder / TEXT("");
+	TArray<FString> Keys;
+	for (const TPair<FString, FEntry>& Entry : Entries)
+	{
+		if (Entry.Key.StartsWith(Prefix))
+		{
+			Keys.Add(Entry.Key);
+		}
+	}
+	for (const FString& Key : Keys)
+	{
+		Remove(Key);
+	}
+}
+
+void FAssetVaultPreviewCache::Reset()
+{
+	Entries.Reset();
+	UsageOrder.Empty();
+	UsedBytes = 0;
+}
+
+void FAssetVaultPreviewCache::Remove(const FString& Key)
+{
+	FEntry Entry;
+	if (Entries.RemoveAndCopyValue(Key, Entry))
+	{
+		UsedBytes -= Entry.Bytes;
+		UsageOrder.RemoveNode(Entry.Node);
+	}
+}
+
+void FAssetVaultPreviewCache::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (TPair<FString, FEntry>& Entry : Entries)
+	{
+		Collector.AddReferencedObject(Entry.Value.Texture);
+	}
+}
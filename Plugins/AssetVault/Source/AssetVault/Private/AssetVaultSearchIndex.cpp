@@ -0,0 +1,392 @@
+#include "AssetVaultSearchIndex.h"
+
+#include "Algo/BinarySearch.h"
+
+namespace AssetVaultSearch
+{
+	// A word found in several fields keeps the weight of the strongest one.
+	constexpr float NameWeight = 8.f;
+	constexpr float TagWeight = 5.f;
+	constexpr float ExportedAssetWeight = 4.f;
+	constexpr float CustomFolderWeight = 3.f;
+	constexpr float DescriptionWeight = 1.f;
+
+	constexpr float ExactFactor = 1.f;
+	constexpr float PrefixFactor = 0.5f;
+	constexpr float TypoFactor = 0.35f;
+
+	// Optimal string alignment distance, gives up (returns MaxDistance + 1) as soon as it is exceeded.
+	static int32 BoundedEditDistance(const TCHAR* A, int32 LenA, const TCHAR* B, int32 LenB, int32 MaxDistance)
+	{
+		if (FMath::Abs(LenA - LenB) > MaxDistance)
+		{
+			return MaxDistance + 1;
+		}
+
+		TArray<int32, TInlineAllocator<64>> Rows;
+		Rows.SetNumUninitialized((LenB + 1) * 3);
+		int32* Previous2 = Rows.GetData();
+		int32* Previous = Previous2 + LenB + 1;
+		int32* Current = Previous + LenB + 1;
+
+		for (int32 J = 0; J <= LenB; ++J)
+		{
+			Previous[J] = J;
+		}
+
+		for (int32 I = 1; I <= LenA; ++I)
+		{
+			Current[0] = I;
+			int32 RowMin = I;
+			for (int32 J = 1; J <= LenB; ++J)
+			{
+				const int32 Cost = A[I - 1] == B[J - 1] ? 0 : 1;
+				int32 Value = FMath::Min3(Previous[J] + 1, Current[J - 1] + 1, Previous[J - 1] + Cost);
+				if (I > 1 && J > 1 && A[I - 1] == B[J - 2] && A[I - 2] == B[J - 1])
+				{
+					Value = FMath::Min(Value, Previous2[J - 2] + 1);
+				}
+				Current[J] = Value;
+				RowMin = FMath::Min(RowMin, Value);
+			}
+
+			if (RowMin > MaxDistance)
+			{
+				return MaxDistance + 1;
+			}
+
+			int32* Recycled = Previous2;
+			Previous2 = Previous;
+			Previous = Current;
+			Current = Recycled;
+		}
+
+		return Previous[LenB];
+	}
+}
+
+void FAssetVaultSearchIndex::Tokenize(const FString& Text, TArray<FString>& OutTokens)
+{
+	FString Token;
+	auto Flush = [&Token, &OutTokens]()
+	{
+		if (!Token.IsEmpty())
+		{
+			OutTokens.Add(MoveTemp(Token));
+			Token.Reset();
+		}
+	};
+
+	const int32 Len = Text.Len();
+	for (int32 Index = 0; Index < Len; ++Index)
+	{
+		const TCHAR Char = Text[Index];
+		if (!FChar::IsAlnum(Char))
+		{
+			Flush();
+			continue;
+		}
+
+		if (Index > 0 && !Token.IsEmpty())
+		{
+			const TCHAR PrevChar = Text[Index - 1];
+			const bool bNextIsLower = Index + 1 < Len && FChar::IsLower(Text[Index + 1]);
+
+			// "rockLarge" -> rock|large, "HTTPServer" -> http|server, "Rock02" -> rock|02
+			const bool bCaseBoundary = FChar::IsUpper(Char) && (FChar::IsLower(PrevChar) || (FChar::IsUpper(PrevChar) && bNextIsLower));
+			const bool bDigitBoundary = FChar::IsDigit(Char) != FChar::IsDigit(PrevChar);
+			if (bCaseBoundary || bDigitBoundary)
+			{
+				Flush();
+			}
+		}
+
+		Token.AppendChar(FChar::ToLower(Char));
+	}
+	Flush();
+}
+
+int32 FAssetVaultSearchIndex::AddOrUpdate(const FString& Key, const FAssetExportOptions& Options, const FDateTime& Timestamp)
+{
+	int32 Handle = FindHandle(Key);
+	if (Handle != INDEX_NONE)
+	{
+		UnindexDocument(Handle);
+	}
+	else
+	{
+		Handle = FreeHandles.Num() > 0 ? FreeHandles.Pop(EAllowShrinking::No) : Documents.AddDefaulted();
+		HandlesByKey.Add(Key, Handle);
+	}
+
+	FDocument& Document = Documents[Handle];
+	Document.Key = Key;
+	Document.Options = Options;
+	Document.Timestamp = Timestamp;
+	Document.bValid = true;
+
+	IndexDocument(Handle);
+	++Revision;
+	return Handle;
+}
+
+bool FAssetVaultSearchIndex::Remove(const FString& Key)
+{
+	int32 Handle = INDEX_NONE;
+	if (!HandlesByKey.RemoveAndCopyValue(Key, Handle))
+	{
+		return false;
+	}
+
+	UnindexDocument(Handle);
+	Documents[Handle] = FDocument();
+	FreeHandles.Add(Handle);
+	++Revision;
+	return true;
+}
+
+void FAssetVaultSearchIndex::Reset()
+{
+	Documents.Reset();
+	FreeHandles.Reset();
+	HandlesByKey.Reset();
+	Terms.Reset();
+	TermIds.Reset();
+	SortedTermIds.Reset();
+	++Revision;
+}
+
+int32 FAssetVaultSearchIndex::FindHandle(const FString& Key) const
+{
+	const int32* Handle = HandlesByKey.Find(Key);
+	return Handle ? *Handle : INDEX_NONE;
+}
+
+int32 FAssetVaultSearchIndex::FindOrAddTerm(const FString& Text)
+{
+	if (const int32* TermId = TermIds.Find(Text))
+	{
+		return *TermId;
+	}
+
+	const int32 TermId = Terms.Add({ Text, {} });
+	TermIds.Add(Text, TermId);
+
+	const int32 Position = Algo::LowerBoundBy(SortedTermIds, Text, [this](int32 Id) -> const FString& { return Terms[Id].Text; });
+	SortedTermIds.Insert(TermId, Position);
+	return TermId;
+}
+
+void FAssetVaultSearchIndex::IndexDocument(int32 Handle)
+{
+	const FAssetExportOptions& Options = Documents[Handle].Options;
+
+	TMap<FString, float> DocumentTerms;
+	TArray<FString> Tokens;
+	auto AddField = [&DocumentTerms, &Tokens](const FString& Text, float Weight)
+	{
+		Tokens.Reset();
+		Tokenize(Text, Tokens);
+		for (FString& Token : Tokens)
+		{
+			float& TermWeight = DocumentTerms.FindOrAdd(MoveTemp(Token), 0.f);
+			TermWeight = FMath::Max(TermWeight, Weight);
+		}
+	};
+
+	AddField(Options.MainInfo.Name, AssetVaultSearch::NameWeight);
+	AddField(Options.MainInfo.Description, AssetVaultSearch::DescriptionWeight);
+	AddField(Options.MainInfo.CustomFolder, AssetVaultSearch::CustomFolderWeight);
+	for (const FString& Tag : Options.AdditionalInfo.Tags)
+	{
+		AddField(Tag, AssetVaultSearch::TagWeight);
+	}
+	for (const FString& AssetName : Options.MainInfo.ExportedAssetNames)
+	{
+		AddField(AssetName, AssetVaultSearch::ExportedAssetWeight);
+	}
+
+	TArray<int32>& DocumentTermIds = Documents[Handle].TermIds;
+	DocumentTermIds.Reset(DocumentTerms.Num());
+	for (const TPair<FString, float>& Pair : DocumentTerms)
+	{
+		const int32 TermId = FindOrAddTerm(Pair.Key);
+		Terms[TermId].Postings.Add({ Handle, Pair.Value });
+		DocumentTermIds.Add(TermId);
+	}
+}
+
+void FAssetVaultSearchIndex::UnindexDocument(int32 Handle)
+{
+	for (const int32 TermId : Documents[Handle].TermIds)
+	{
+		Terms[TermId].Postings.RemoveAllSwap([Handle](const FPosting& Posting) { return Posting.Handle == Handle; }, EAllowShrinking::No);
+	}
+	Documents[Handle].TermIds.Reset();
+}
+
+void FAssetVaultSearchIndex::MatchTerms(const FString& Token, TArray<TPair<int32, float>>& OutMatches) const
+{
+	auto GetText = [this](int32 Id) -> const FString& { return Terms[Id].Text; };
+
+	// Exact and prefix matches form one contiguous range of the sorted terms.
+	const int32 PrefixStart = Algo::LowerBoundBy(SortedTermIds, Token, GetText);
+	int32 PrefixEnd = PrefixStart;
+	for (; PrefixEnd < SortedTermIds.Num(); ++PrefixEnd)
+	{
+		const FTerm& Term = Terms[SortedTermIds[PrefixEnd]];
+		if (!Term.Text.StartsWith(Token, ESearchCase::CaseSensitive))
+		{
+			break;
+		}
+		if (Term.Postings.Num() > 0)
+		{
+			// Shorter completions are closer to what was typed.
+			const float Factor = Term.Text.Len() == Token.Len()
+				? AssetVaultSearch::ExactFactor
+				: AssetVaultSearch::PrefixFactor * (0.5f + 0.5f * Token.Len() / Term.Text.Len());
+			OutMatches.Emplace(SortedTermIds[PrefixEnd], Factor);
+		}
+	}
+
+	if (Token.Len() < 4)
+	{
+		return;
+	}
+
+	// Typos are only looked for among terms sharing the first letter, which keeps the candidate range small.
+	const int32 MaxDistance = Token.Len() >= 8 ? 2 : 1;
+	const FString FirstLetter = Token.Left(1);
+	const int32 LetterStart = Algo::LowerBoundBy(SortedTermIds, FirstLetter, GetText);
+
+	for (int32 Index = LetterStart; Index < SortedTermIds.Num(); ++Index)
+	{
+		if (Index >= PrefixStart && Index < PrefixEnd)
+		{
+			continue;
+		}
+
+		const FTerm& Term = Terms[SortedTermIds[Index]];
+		if (Term.Text[0] != Token[0])
+		{
+			break;
+		}
+		if (Term.Postings.Num() == 0 || Term.Text.Len() < Token.Len() - MaxDistance)
+		{
+			continue;
+		}
+
+		// Compare against the whole term and against its start, for words that are still being typed.
+		float Factor = AssetVaultSearch::TypoFactor;
+		int32 Distance = AssetVaultSearch::BoundedEditDistance(*Token, Token.Len(), *Term.Text, Term.Text.Len(), MaxDistance);
+		if (Distance > MaxDistance && Term.Text.Len() > Token.Len())
+		{
+			Distance = AssetVaultSearch::BoundedEditDistance(*Token, Token.Len(), *Term.Text, Token.Len(), MaxDistance);
+			Factor *= AssetVaultSearch::PrefixFactor;
+		}
+		if (Distance <= MaxDistance)
+		{
+			OutMatches.Emplace(SortedTermIds[Index], Factor / Distance);
+		}
+	}
+}
+
+void FAssetVaultSearchIndex::Search(const FString& Query, EAssetType FilterType, int32 MaxResults, TArray<FAssetVaultSearchHit>& OutHits) const
+{
+	OutHits.Reset();
+
+	auto PassesFilter = [this, FilterType](int32 Handle)
+	{
+		return Documents[Handle].bValid && (FilterType == EAssetType::All || Documents[Handle].Options.MainInfo.AssetType == FilterType);
+	};
+
+	TArray<FString> QueryTokens;
+	Tokenize(Query, QueryTokens);
+
+	TArray<FString> UniqueTokens;
+	for (FString& Token : QueryTokens)
+	{
+		UniqueTokens.AddUnique(MoveTemp(Token));
+	}
+
+	if (UniqueTokens.Num() == 0)
+	{
+		for (int32 Handle = 0; Handle < Documents.Num(); ++Handle)
+		{
+			if (PassesFilter(Handle))
+			{
+				OutHits.Add({ Handle, 0.f });
+			}
+		}
+	}
+	else
+	{
+		TArray<float> TotalScores;
+		TArray<float> TokenScores;
+		TArray<int32> MatchedTokens;
+		TArray<int32> Touched;
+		TotalScores.SetNumZeroed(Documents.Num());
+		TokenScores.SetNumZeroed(Documents.Num());
+		MatchedTokens.SetNumZeroed(Documents.Num());
+
+		TArray<TPair<int32, float>> Matches;
+
+		for (int32 TokenIndex = 0; TokenIndex < UniqueTokens.Num(); ++TokenIndex)
+		{
+			Matches.Reset();
+			MatchTerms(UniqueTokens[TokenIndex], Matches);
+			if (Matches.Num() == 0)
+			{
+				return;
+			}
+
+			// A word scores through its best matching term in each entry.
+			for (const TPair<int32, float>& Match : Matches)
+			{
+				for (const FPosting& Posting : Terms[Match.Key].Postings)
+				{
+					if (MatchedTokens[Posting.Handle] != TokenIndex)
+					{
+						continue;
+					}
+					float& Score = TokenScores[Posting.Handle];
+					if (Score == 0.f)
+					{
+						Touched.Add(Posting.Handle);
+					}
+					Score = FMath::Max(Score, Posting.Weight * Match.Value);
+				}
+			}
+
+			for (const int32 Handle : Touched)
+			{
+				TotalScores[Handle] += TokenScores[Handle];
+				TokenScores[Handle] = 0.f;
+				++MatchedTokens[Handle];
+			}
+			Touched.Reset();
+		}
+
+		for (int32 Handle = 0; Handle < Documents.Num(); ++Handle)
+		{
+			if (MatchedTokens[Handle] == UniqueTokens.Num() && PassesFilter(Handle))
+			{
+				OutHits.Add({ Handle, TotalScores[Handle] });
+			}
+		}
+	}
+
+	OutHits.Sort([this](const FAssetVaultSearchHit& A, const FAssetVaultSearchHit& B)
+	{
+		if (A.Score != B.Score)
+		{
+			return A.Score > B.Score;
+		}
+		return Documents[A.Handle].Options.MainInfo.Name < Documents[B.Handle].Options.MainInfo.Name;
+	});
+
+	if (MaxResults > 0 && OutHits.Num() > MaxResults)
+	{
+		OutHits.SetNum(MaxResults, EAllowShrinking::No);
+	}
+}
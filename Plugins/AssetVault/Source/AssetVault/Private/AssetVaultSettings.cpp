@@ -0,0 +1,14 @@
+#include "AssetVaultSettings.h"
+
+#include "HAL/PlatformMisc.h"
+
+int32 UAssetVaultSettings::GetEffectiveCopyWorkerCount() const
+{
+	if (CopyWorkerCount > 0)
+	{
+		return CopyWorkerCount;
+	}
+
+	// Copying is mostly I/O bound, a handful of workers saturates local disks and network shares alike.
+	return FMath::Clamp(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 1, 16);
+}
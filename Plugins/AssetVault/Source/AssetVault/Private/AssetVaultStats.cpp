@@ -0,0 +1,32 @@
+#include "AssetVaultStats.h"
+
+DEFINE_STAT(STAT_AssetVault_Export);
+DEFINE_STAT(STAT_AssetVault_ResolveClosure);
+DEFINE_STAT(STAT_AssetVault_Copy);
+DEFINE_STAT(STAT_AssetVault_WriteMetadata);
+DEFINE_STAT(STAT_AssetVault_Scan);
+DEFINE_STAT(STAT_AssetVault_Parse);
+DEFINE_STAT(STAT_AssetVault_Import);
+DEFINE_STAT(STAT_AssetVault_ConflictCheck);
+DEFINE_STAT(STAT_AssetVault_RegistryScan);
+DEFINE_STAT(STAT_AssetVault_Unload);
+DEFINE_STAT(STAT_AssetVault_Load);
+DEFINE_STAT(STAT_AssetVault_Delete);
+
+DEFINE_STAT(STAT_AssetVault_PackagesResolved);
+DEFINE_STAT(STAT_AssetVault_FilesCopied);
+DEFINE_STAT(STAT_AssetVault_FilesUnchanged);
+DEFINE_STAT(STAT_AssetVault_FilesHashed);
+DEFINE_STAT(STAT_AssetVault_FilesParsed);
+DEFINE_STAT(STAT_AssetVault_CacheHits);
+DEFINE_STAT(STAT_AssetVault_CacheMisses);
+DEFINE_STAT(STAT_AssetVault_BytesCopied);
+
+TRACE_DECLARE_INT_COUNTER(AssetVault_PackagesResolved, TEXT("AssetVault/Packages Resolved"));
+TRACE_DECLARE_INT_COUNTER(AssetVault_FilesCopied, TEXT("AssetVault/Files Copied"));
+TRACE_DECLARE_INT_COUNTER(AssetVault_FilesUnchanged, TEXT("AssetVault/Files Unchanged"));
+TRACE_DECLARE_INT_COUNTER(AssetVault_FilesHashed, TEXT("AssetVault/Files Hashed"));
+TRACE_DECLARE_INT_COUNTER(AssetVault_FilesParsed, TEXT("AssetVault/Metadata Files Parsed"));
+TRACE_DECLARE_INT_COUNTER(AssetVault_CacheHits, TEXT("AssetVault/Dependency Cache Hits"));
+TRACE_DECLARE_INT_COUNTER(AssetVault_CacheMisses, TEXT("AssetVault/Dependency Cache Misses"));
+TRACE_DECLARE_MEMORY_COUNTER(AssetVault_BytesCopied, TEXT("AssetVault/Bytes Copied"));
@@ -0,0 +1,286 @@
+#include "AssetVaultSubsystem.h"
+#include "AssetVault.h"
+#include "AssetVaultBlobStore.h"
+#include "AssetVaultCatalog.h"
+#include "AssetVaultSettings.h"
+
+#include "DirectoryWatcherModule.h"
+#include "HAL/PlatformTime.h"
+#include "IDirectoryWatcher.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+
+void UAssetVaultSubsystem::Deinitialize()
+{
+	CloseVault();
+	Super::Deinitialize();
+}
+
+bool UAssetVaultSubsystem::OpenVault(const FString& VaultRoot)
+{
+	CloseVault();
+
+	if (!FPaths::DirectoryExists(VaultRoot))
+	{
+		UE_LOG(LogAssetVault, Warning, TEXT("Cannot open vault, directory does not exist: %s"), *VaultRoot);
+		return false;
+	}
+
+	const bool bUseCatalog = GetDefault<UAssetVaultSettings>()->bUseVaultCatalog;
+
+	Catalog = MakeShared<FAssetVaultCatalog>(VaultRoot);
+	if (bUseCatalog)
+	{
+		Catalog->Load();
+	}
+	if (Catalog->Refresh() && bUseCatalog)
+	{
+		Catalog->Save();
+	}
+
+	Catalog->ForEachEntry([this](const FString& MetadataPath, const FAssetVaultCatalogEntry& Entry)
+	{
+		SearchIndex.AddOrUpdate(MetadataPath, Entry.Options, Entry.Timestamp);
+	});
+
+	WatchedDirectory = Catalog->GetVaultRoot();
+
+	FDirectoryWatcherModule& DirectoryWatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+	if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule.Get())
+	{
+		DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(
+			WatchedDirectory,
+			IDirectoryWatcher::FDirectoryChanged::CreateUObject(this, &UAssetVaultSubsystem::HandleDirectoryChanged),
+			WatcherHandle,
+			IDirectoryWatcher::WatchOptions::IncludeDirectoryChanges);
+	}
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UAssetVaultSubsystem::Tick), 0.1f);
+	return true;
+}
+
+void UAssetVaultSubsystem::CloseVault()
+{
+	if (WatcherHandle.IsValid())
+	{
+		if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+		{
+			if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+			{
+				DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(WatchedDirectory, WatcherHandle);
+			}
+		}
+		WatcherHandle.Reset();
+	}
+
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	Catalog.Reset();
+	SearchIndex.Reset();
+	PreviewCache.Reset();
+	EntryViews.Reset();
+	WatchedDirectory.Reset();
+	PendingDirs.Reset();
+	bFullRefreshPending = false;
+}
+
+FString UAssetVaultSubsystem::GetVaultRoot() const
+{
+	return WatchedDirectory;
+}
+
+TArray<FAssetExportOptions> UAssetVaultSubsystem::GetAllEntries() const
+{
+	TArray<FAssetExportOptions> Entries;
+	if (Catalog.IsValid())
+	{
+		Catalog->GetAllEntries(Entries);
+	}
+	return Entries;
+}
+
+TArray<FAssetExportOptions> UAssetVaultSubsystem::SearchEntries(const FString& Query, EAssetType FilterType, int32 MaxResults) const
+{
+	TArray<FAssetVaultSearchHit> Hits;
+	SearchIndex.Search(Query, FilterType, MaxResults, Hits);
+
+	TArray<FAssetExportOptions> Entries;
+	Entries.Reserve(Hits.Num());
+	for (const FAssetVaultSearchHit& Hit : Hits)
+	{
+		Entries.Add(SearchIndex.GetEntry(Hit.Handle));
+	}
+	return Entries;
+}
+
+int32 UAssetVaultSubsystem::GetEntryCount(EAssetType FilterType)
+{
+	return GetEntryView(FilterType, EAssetVaultSortKey::Name, false).Num();
+}
+
+TArray<FAssetExportOptions> UAssetVaultSubsystem::GetEntryPage(EAssetType FilterType, EAssetVaultSortKey SortKey, bool bDescending, int32 PageIndex, int32 PageSize)
+{
+	TArray<int32> Handles;
+	GetEntryView(FilterType, SortKey, bDescending).GetPage(PageIndex, PageSize, Handles);
+
+	TArray<FAssetExportOptions> Entries;
+	Entries.Reserve(Handles.Num());
+	for (const int32 Handle : Handles)
+	{
+		Entries.Add(SearchIndex.GetEntry(Handle));
+	}
+	return Entries;
+}
+
+UTexture2D* UAssetVaultSubsystem::GetPreviewTexture(const FAssetExportOptions& Entry, const FString& AssetName)
+{
+	const TArray<FString>& Previews = Entry.AdditionalInfo.PreviewImagePaths;
+	const FString* PreviewName = nullptr;
+	if (AssetName.IsEmpty())
+	{
+		PreviewName = Previews.Num() > 0 ? &Previews[0] : nullptr;
+	}
+	else
+	{
+		PreviewName = Previews.FindByKey(AssetName);
+		if (!PreviewName)
+		{
+			PreviewName = Previews.FindByPredicate([&AssetName](const FString& ObjectPath) { return FPackageName::ObjectPathToObjectName(ObjectPath) == AssetName; });
+		}
+	}
+
+	if (!Catalog.IsValid() || !PreviewName)
+	{
+		return nullptr;
+	}
+
+	if (!PreviewCache.IsValid())
+	{
+		PreviewCache = MakeUnique<FAssetVaultPreviewCache>(static_cast<int64>(GetDefault<UAssetVaultSettings>()->PreviewCacheSizeMB) * 1024 * 1024);
+	}
+	return PreviewCache->Get(FPaths::Combine(WatchedDirectory, Entry.MainInfo.RelativeExportPath), *PreviewName);
+}
+
+FAssetVaultEntryView UAssetVaultSubsystem::GetEntryView(EAssetType FilterType, EAssetVaultSortKey SortKey, bool bDescending)
+{
+	return EntryViews.GetView(SearchIndex, FilterType, SortKey, bDescending);
+}
+
+void UAssetVaultSubsystem::HandleDirectoryChanged(const TArray<FFileChangeData>& FileChanges)
+{
+	for (const FFileChangeData& Change : FileChanges)
+	{
+		if (Change.Action == FFileChangeData::FCA_RescanRequired)
+		{
+			bFullRefreshPending = true;
+			continue;
+		}
+
+		FString ChangedPath = FPaths::ConvertRelativePathToFull(Change.Filename);
+		FPaths::NormalizeFilename(ChangedPath);
+
+		// Our own writes: catalog saves, temp files of atomic writes, blob store contents.
+		const FString FileName = FPaths::GetCleanFilename(ChangedPath);
+		if (FileName == FAssetVaultCatalog::FileName
+			|| ChangedPath.EndsWith(TEXT(".tmp"))
+			|| ChangedPath.Contains(FAssetVaultBlobStore::DirectoryName))
+		{
+			continue;
+		}
+
+		FString RelativeDir = FPaths::GetPath(ChangedPath);
+		if (!FPaths::MakePathRelativeTo(RelativeDir, *(WatchedDirectory / TEXT(""))))
+		{
+			continue;
+		}
+
+		// The parent also covers added or removed directories, they show up in its listing.
+		PendingDirs.Add(RelativeDir);
+	}
+
+	if (PendingDirs.Num() > 0 || bFullRefreshPending)
+	{
+		LastChangeTime = FPlatformTime::Seconds();
+	}
+}
+
+bool UAssetVaultSubsystem::Tick(float DeltaTime)
+{
+	if ((PendingDirs.Num() > 0 || bFullRefreshPending)
+		&& FPlatformTime::Seconds() - LastChangeTime >= GetDefault<UAssetVaultSettings>()->WatchDebounceSeconds)
+	{
+		ApplyPendingChanges();
+	}
+	return true;
+}
+
+void UAssetVaultSubsystem::ApplyPendingChanges()
+{
+	if (!Catalog.IsValid())
+	{
+		return;
+	}
+
+	FAssetVaultChangeSet Changes;
+	FAssetVaultCatalogRefreshContext Context;
+	Context.Changes = &Changes;
+
+	const bool bChanged = bFullRefreshPending
+		? Catalog->Refresh(&Context)
+		: Catalog->RefreshSubtrees(PendingDirs.Array(), &Context);
+
+	PendingDirs.Reset();
+	bFullRefreshPending = false;
+
+	if (bChanged && GetDefault<UAssetVaultSettings>()->bUseVaultCatalog)
+	{
+		Catalog->Save();
+	}
+
+	if (!Changes.IsEmpty())
+	{
+		ApplyToSearchIndex(Changes);
+
+		if (PreviewCache.IsValid())
+		{
+			for (const TArray<FString>* ChangedFiles : { &Changes.ModifiedFiles, &Changes.RemovedFiles })
+			{
+				for (const FString& MetadataPath : *ChangedFiles)
+				{
+					PreviewCache->Invalidate(FPaths::Combine(WatchedDirectory, FPaths::GetPath(MetadataPath)));
+				}
+			}
+		}
+
+		UE_LOG(LogAssetVault, Log, TEXT("Watched changes: %d added, %d modified, %d removed"),
+			Changes.Added.Num(), Changes.Modified.Num(), Changes.Removed.Num());
+		OnEntriesChanged.Broadcast(Changes);
+	}
+}
+
+void UAssetVaultSubsystem::ApplyToSearchIndex(const FAssetVaultChangeSet& Changes)
+{
+	for (const FString& MetadataPath : Changes.RemovedFiles)
+	{
+		SearchIndex.Remove(MetadataPath);
+	}
+
+	auto AddOrUpdate = [this](const FString& MetadataPath, const FAssetExportOptions& Options)
+	{
+		const FAssetVaultCatalogEntry* Entry = Catalog->FindEntry(MetadataPath);
+		SearchIndex.AddOrUpdate(MetadataPath, Options, Entry ? Entry->Timestamp : FDateTime());
+	};
+	for (int32 Index = 0; Index < Changes.AddedFiles.Num(); ++Index)
+	{
+		AddOrUpdate(Changes.AddedFiles[Index], Changes.Added[Index]);
+	}
+	for (int32 Index = 0; Index < Changes.ModifiedFiles.Num(); ++Index)
+	{
+		AddOrUpdate(Changes.ModifiedFiles[Index], Changes.Modified[Index]);
+	}
+}
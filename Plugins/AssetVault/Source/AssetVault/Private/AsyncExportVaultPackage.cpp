@@ -0,0 +1,130 @@
+#include "AsyncExportVaultPackage.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "HAL/PlatformTime.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+UAsyncExportVaultPackage* UAsyncExportVaultPackage::ExportAssetsToPackageAsync(const TArray<UObject*>& Assets, const FString& ExportDirectory, const FAssetExportOptions& ExportOptions)
+{
+	UAsyncExportVaultPackage* Action = NewObject<UAsyncExportVaultPackage>();
+	for (UObject* Asset : Assets)
+	{
+		if (Asset)
+		{
+			Action->RootPackages.AddUnique(Asset->GetOutermost()->GetFName());
+		}
+	}
+	Action->ExportDirectory = ExportDirectory;
+	Action->ExportOptions = ExportOptions;
+	// Same metadata file naming as the synchronous exports.
+	Action->MetadataBaseName = Assets.Num() == 1 && Assets[0] ? Assets[0]->GetName() : ExportOptions.MainInfo.Name;
+	return Action;
+}
+
+void UAsyncExportVaultPackage::Cancel()
+{
+	Progress->Cancel();
+}
+
+void UAsyncExportVaultPackage::Activate()
+{
+	// Kept alive by the root set until the export has finished.
+	AddToRoot();
+
+	if (RootPackages.Num() == 0)
+	{
+		Finish(false, TEXT("Export failed: no assets provided."));
+		return;
+	}
+
+	// The export looks the registry up from a worker, where loading the module would ensure.
+	FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+	Notification = UAssetPackageManager::ShowEditorProgressNotification(
+		FString::Printf(TEXT("Exporting %s..."), *ExportOptions.MainInfo.Name),
+		FSimpleDelegate::CreateUObject(this, &UAsyncExportVaultPackage::Cancel));
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UAsyncExportVaultPackage::Tick), 0.1f);
+
+	Async(EAsyncExecution::ThreadPool, [this, Roots = RootPackages, Directory = ExportDirectory, Options = ExportOptions, BaseName = MetadataBaseName, InProgress = Progress]()
+	{
+		FString Message;
+		const bool bSuccess = UAssetPackageManager::ExportPackagesToFolder(Roots, Directory, Options, BaseName, Message, &InProgress.Get());
+
+		AsyncTask(ENamedThreads::GameThread, [this, bSuccess, Message = MoveTemp(Message)]()
+		{
+			Finish(bSuccess, Message);
+		});
+	});
+}
+
+FAssetVaultExportStatus UAsyncExportVaultPackage::GetStatus()
+{
+	FAssetVaultExportStatus Status;
+	Status.Phase = Progress->Phase.load();
+	Status.PackagesResolved = Progress->PackagesResolved.load();
+	Status.PackagesCopied = Progress->Copy.JobsDone.load();
+	Status.PackagesTotal = Progress->Copy.NumJobs.load();
+	Status.BytesCopied = Progress->Copy.BytesCopied.load();
+
+	if (Status.Phase == EAssetVaultExportPhase::Copying)
+	{
+		const double Now = FPlatformTime::Seconds();
+		if (CopyStartTime == 0.0)
+		{
+			CopyStartTime = Now;
+		}
+		// Packages vary in size, but their count is known up front while the byte total is not.
+		if (Status.PackagesCopied > 0 && Status.PackagesTotal > 0)
+		{
+			const double PerPackage = (Now - CopyStartTime) / Status.PackagesCopied;
+			Status.RemainingSeconds = static_cast<float>(PerPackage * (Status.PackagesTotal - Status.PackagesCopied));
+		}
+	}
+	return Status;
+}
+
+bool UAsyncExportVaultPackage::Tick(float DeltaTime)
+{
+	const FAssetVaultExportStatus Status = GetStatus();
+
+	if (Notification.IsValid())
+	{
+		FString Text;
+		switch (Status.Phase)
+		{
+		case EAssetVaultExportPhase::ResolvingDependencies:
+			Text = FString::Printf(TEXT("Resolving dependencies: %d packages"), Status.PackagesResolved);
+			break;
+		case EAssetVaultExportPhase::Copying:
+			Text = FString::Printf(TEXT("Copying %d / %d packages (%.1f MB)"), Status.PackagesCopied, Status.PackagesTotal, Status.BytesCopied / (1024.0 * 1024.0));
+			if (Status.RemainingSeconds >= 0.0f)
+			{
+				Text += FString::Printf(TEXT(", about %.0f s left"), FMath::CeilToFloat(Status.RemainingSeconds));
+			}
+			break;
+		case EAssetVaultExportPhase::Finalizing:
+			Text = TEXT("Writing metadata...");
+			break;
+		}
+		Notification->SetText(FText::FromString(Text));
+	}
+
+	OnProgress.Broadcast(Status);
+	return true;
+}
+
+void UAsyncExportVaultPackage::Finish(bool bSuccess, const FString& Message)
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	const FString FinalMessage = bSuccess
+		? FString::Printf(TEXT("%s exported"), *ExportOptions.MainInfo.Name)
+		: (Message.IsEmpty() ? TEXT("Export failed.") : Message);
+	UAssetPackageManager::CompleteEditorNotification(Notification, FinalMessage, bSuccess);
+	Notification.Reset();
+
+	OnCompleted.Broadcast(bSuccess, FinalMessage);
+	SetReadyToDestroy();
+	RemoveFromRoot();
+}
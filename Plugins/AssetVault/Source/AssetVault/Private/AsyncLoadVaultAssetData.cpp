@@ -0,0 +1,97 @@
+#include "AsyncLoadVaultAssetData.h"
+#include "AssetVaultCatalog.h"
+#include "AssetVaultSettings.h"
+
+#include "Async/Async.h"
+
+UAsyncLoadVaultAssetData* UAsyncLoadVaultAssetData::LoadAllAssetDataFromDirectoryAsync(const FString& DirectoryPath, int32 BatchSize)
+{
+	UAsyncLoadVaultAssetData* Action = NewObject<UAsyncLoadVaultAssetData>();
+	Action->DirectoryPath = DirectoryPath;
+	Action->BatchSize = FMath::Max(BatchSize, 1);
+	return Action;
+}
+
+void UAsyncLoadVaultAssetData::Cancel()
+{
+	CancelFlag->store(true);
+}
+
+void UAsyncLoadVaultAssetData::RunOnGameThread(TUniqueFunction<void(UAsyncLoadVaultAssetData&)> Function)
+{
+	// The action stays rooted until the completion task, which is queued after every batch task.
+	AsyncTask(ENamedThreads::GameThread, [this, Function = MoveTemp(Function)]()
+	{
+		if (!CancelFlag->load())
+		{
+			Function(*this);
+		}
+	});
+}
+
+void UAsyncLoadVaultAssetData::Activate()
+{
+	// Kept alive by the root set until the background scan has finished.
+	AddToRoot();
+
+	const bool bUseCatalog = GetDefault<UAssetVaultSettings>()->bUseVaultCatalog;
+
+	Async(EAsyncExecution::ThreadPool, [this, bUseCatalog, Path = DirectoryPath, InBatchSize = BatchSize, InCancelFlag = CancelFlag]()
+	{
+		FAssetVaultCatalog Catalog(Path);
+
+		auto SendBatch = [this](TArray<FAssetExportOptions>&& Batch)
+		{
+			RunOnGameThread([Batch = MoveTemp(Batch)](UAsyncLoadVaultAssetData& Action)
+			{
+				Action.OnBatch.Broadcast(Batch);
+			});
+		};
+
+		const bool bCatalogLoaded = bUseCatalog && Catalog.Load();
+		if (bCatalogLoaded)
+		{
+			Catalog.ForEachBatch(InBatchSize, SendBatch);
+		}
+
+		// Without a cached catalog there is nothing on screen yet, stream entries as they are parsed.
+		FAssetVaultCatalogRefreshContext Context;
+		Context.BatchSize = InBatchSize;
+		Context.CancelFlag = &InCancelFlag.Get();
+		if (!bCatalogLoaded)
+		{
+			Context.OnEntriesParsed = SendBatch;
+		}
+
+		const bool bChanged = Catalog.Refresh(&Context);
+		const bool bCancelled = InCancelFlag->load();
+
+		if (!bCancelled)
+		{
+			if (bChanged && bUseCatalog)
+			{
+				Catalog.Save();
+			}
+
+			if (bChanged && bCatalogLoaded)
+			{
+				RunOnGameThread([](UAsyncLoadVaultAssetData& Action)
+				{
+					Action.OnReset.Broadcast();
+				});
+				Catalog.ForEachBatch(InBatchSize, SendBatch);
+			}
+		}
+
+		const int32 TotalEntries = Catalog.NumEntries();
+		AsyncTask(ENamedThreads::GameThread, [this, TotalEntries, bCancelled]()
+		{
+			if (!bCancelled && !CancelFlag->load())
+			{
+				OnCompleted.Broadcast(TotalEntries);
+			}
+			SetReadyToDestroy();
+			RemoveFromRoot();
+		});
+	});
+}
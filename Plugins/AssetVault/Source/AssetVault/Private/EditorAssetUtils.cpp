@@ -1,4 +1,5 @@
 #include "EditorAssetUtils.h"
+#include "AssetVault.h"
 #include "EditorUtilityLibrary.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Editor.h"
@@ -27,11 +28,11 @@ void UEditorAssetUtils::AddUniqueAssets_ByPath(TArray<UObject*>& ExistingAssets,
 			ExistingAssets.Add(Asset);
 			NewlyAdded.Add(Asset);
 
-			UE_LOG(LogTemp, Log, TEXT("Added by path: %s"), *AssetPath);
+			UE_LOG(LogAssetVault, Verbose, TEXT("Added by path: %s"), *AssetPath);
 		}
 		else
 		{
-			UE_LOG(LogTemp, Log, TEXT("Duplicate skipped: %s"), *AssetPath);
+			UE_LOG(LogAssetVault, Verbose, TEXT("Duplicate skipped: %s"), *AssetPath);
 		}
 	}
 }
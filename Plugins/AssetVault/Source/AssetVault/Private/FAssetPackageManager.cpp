@@ -1,9 +1,26 @@
 ﻿#include "FAssetPackageManager.h"
-
+#include "AssetVault.h"
+#include "AssetVaultArchive.h"
+#include "AssetVaultBlobStore.h"
+#include "AssetVaultCatalog.h"
+#include "AssetVaultCopyEngine.h"
+#include "AssetVaultDependencyCache.h"
+#include "AssetVaultDependencyScope.h"
+#include "AssetVaultFileHash.h"
+#include "AssetVaultFileManifest.h"
+#include "AssetVaultImportLoader.h"
+#include "AssetVaultJournal.h"
+#include "AssetVaultMetadata.h"
+#include "AssetVaultPreviews.h"
+#include "AssetVaultSettings.h"
+#include "AssetVaultStats.h"
+
+#include "Async/ParallelFor.h"
 #include "HAL/FileManager.h"
 #include "HAL/PlatformFilemanager.h"
 #include "Misc/AssetRegistryInterface.h"
 #include "Misc/FileHelper.h"
+#include "Misc/Optional.h"
 #include "Misc/PackageName.h"
 #include "Misc/Paths.h"
 #include "Modules/ModuleManager.h"
@@ -19,32 +36,412 @@
 #include "ContentBrowserModule.h"
 #include "IContentBrowserSingleton.h"
 
-#include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetRegistry/IAssetRegistry.h"
 
 #include "Styling/AppStyle.h"
 #include "Widgets/Notifications/SNotificationList.h"
 #include "Framework/Notifications/NotificationManager.h"
 
-EAssetType StringToAssetType(const FString& AssetTypeStr)
+static void CollectExportedAssetNames(const FAssetVaultCopyReport& Report, TArray<FString>& OutNames)
 {
+	TSet<FString> SeenNames;
+	for (const FAssetVaultCopyResult& Result : Report.Results)
+	{
+		if (Result.Status != EAssetVaultCopyStatus::Copied && Result.Status != EAssetVaultCopyStatus::Unchanged)
+		{
+			continue;
+		}
 
-	if (AssetTypeStr.Equals(TEXT("All"), ESearchCase::IgnoreCase))
-		return EAssetType::All;
-	if (AssetTypeStr.Equals(TEXT("Blueprint"), ESearchCase::IgnoreCase))
-		return EAssetType::Blueprint;
-	else if (AssetTypeStr.Equals(TEXT("Material"), ESearchCase::IgnoreCase))
-		return EAssetType::Material;
-	else if (AssetTypeStr.Equals(TEXT("Level"), ESearchCase::IgnoreCase))
-		return EAssetType::Level;
-	else if (AssetTypeStr.Equals(TEXT("Texture"), ESearchCase::IgnoreCase))
-		return EAssetType::Texture;
-	else if (AssetTypeStr.Equals(TEXT("StaticMesh"), ESearchCase::IgnoreCase) || AssetTypeStr.Equals(TEXT("Static Mesh"), ESearchCase::IgnoreCase))
-		return EAssetType::StaticMesh;
-	else if (AssetTypeStr.Equals(TEXT("Sound"), ESearchCase::IgnoreCase))
-		return EAssetType::Sound;
-	else
-		return EAssetType::Other;
+		const FString Extension = FPaths::GetExtension(Result.TargetFile);
+		if (Extension != TEXT("uasset") && Extension != TEXT("umap"))
+		{
+			continue;
+		}
+
+		const FString AssetName = FPaths::GetBaseFilename(Result.TargetFile);
+		bool bAlreadySeen = false;
+		SeenNames.Add(AssetName, &bAlreadySeen);
+		if (!bAlreadySeen)
+		{
+			OutNames.Add(AssetName);
+		}
+	}
+}
+
+static FNotificationInfo MakeVaultNotificationInfo(const FString& Message, bool bSuccess)
+{
+	FString Clean = Message;
+	Clean.ReplaceInline(TEXT("\r"), TEXT(""));
+	Clean.ReplaceInline(TEXT("\n"), TEXT(" "));
+	Clean.ReplaceInline(TEXT("\t"), TEXT(" "));
+	if (Clean.IsEmpty())
+	{
+		Clean = bSuccess
+			? TEXT("Операция успешно завершена.")
+			: TEXT("Произошла ошибка.");
+	}
+	
+	const FText TitleText = FText::FromString(Clean);
+	const FText SubText   = FText::FromString(TEXT("Asset Vault Plugin"));
+	
+	FNotificationInfo Info(TitleText);
+	Info.SubText              = SubText;
+	Info.bFireAndForget       = true;
+	Info.FadeInDuration       = 0.3f;
+	Info.ExpireDuration       = 4.0f;
+	Info.FadeOutDuration      = 1.5f;
+	Info.bUseThrobber         = false;
+	Info.bUseSuccessFailIcons = false;  
+	Info.Image = bSuccess?
+		 FAppStyle::GetBrush("Icons.Success"):
+		 FAppStyle::GetBrush("Icons.ErrorWithColor");
+	return Info;
+}
+
+// Storage state of one export call: the optional blob store or archive, the manifest left by the
+// previous export into the same folder and a copy engine configured for them.
+struct FAssetVaultExportSession
+{
+	TOptional<FAssetVaultBlobStore> BlobStore;
+	TUniquePtr<FAssetVaultArchiveWriter> ArchiveWriter;
+	FAssetVaultFileManifest PreviousManifest;
+	TMap<FString, FAssetVaultFileEntry> PreviousFiles;
+	FAssetVaultCopyEngine CopyEngine;
+	bool bWriteManifest = false;
+
+	FAssetVaultExportSession(const FString& ExportDirectory, const FString& TargetFolder)
+	{
+		const UAssetVaultSettings* Settings = GetDefault<UAssetVaultSettings>();
+
+		if (Settings->StorageMode == EAssetVaultStorageMode::Deduplicated)
+		{
+			BlobStore.Emplace(ExportDirectory);
+			CopyEngine.SetBlobStore(BlobStore.GetPtrOrNull());
+		}
+		else if (Settings->StorageMode == EAssetVaultStorageMode::Packed)
+		{
+			// A failed open surfaces as failed copies.
+			ArchiveWriter = MakeUnique<FAssetVaultArchiveWriter>(TargetFolder, Settings->CompressionCodec, Settings->CompressionLevel);
+			ArchiveWriter->Open();
+			CopyEngine.SetArchiveWriter(ArchiveWriter.Get());
+		}
+
+		// Archives are always rewritten as a whole.
+		if (Settings->bIncrementalExport && !ArchiveWriter)
+		{
+			if (FAssetVaultFileManifest::Exists(TargetFolder) && PreviousManifest.Load(TargetFolder))
+			{
+				PreviousFiles = PreviousManifest.MakeTargetPathMap(TargetFolder);
+			}
+			CopyEngine.SetPreviousFiles(&PreviousFiles);
+		}
+
+		bWriteManifest = BlobStore.IsSet() || (Settings->bIncrementalExport && !ArchiveWriter);
+	}
+
+	// Removes what a cancelled export wrote. Blobs stay, other exports may share them. Files that replaced
+	// an earlier export's copy cannot be restored, the manifest is not rewritten so the next incremental
+	// export compares them again.
+	void Discard(const FString& TargetFolder, const FAssetVaultCopyReport& Report, bool bCreatedFolder)
+	{
+		// Deletes the temporary archive.
+		ArchiveWriter.Reset();
+
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		if (bCreatedFolder)
+		{
+			PlatformFile.DeleteDirectoryRecursively(*TargetFolder);
+			return;
+		}
+
+		if (BlobStore.IsSet() || !bWriteManifest)
+		{
+			return;
+		}
+
+		for (const FAssetVaultCopyResult& Result : Report.Results)
+		{
+			if (Result.Status == EAssetVaultCopyStatus::Copied && !PreviousFiles.Contains(Result.TargetFile))
+			{
+				PlatformFile.DeleteFile(*Result.TargetFile);
+			}
+		}
+	}
+
+	// Writes the archive, or the new file manifest and removes loose files that dropped out of the closure.
+	bool Finalize(const FString& TargetFolder, const FAssetVaultCopyReport& Report, const FString& MetadataJson)
+	{
+		if (ArchiveWriter)
+		{
+			return ArchiveWriter->Finalize(MetadataJson);
+		}
+
+		// Imports prefer an archive, one left by an earlier packed export would shadow the files written now.
+		const FString StaleArchive = FAssetVaultArchive::GetPath(TargetFolder);
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		if (PlatformFile.FileExists(*StaleArchive) && !PlatformFile.DeleteFile(*StaleArchive))
+		{
+			UE_LOG(LogAssetVault, Error, TEXT("Failed to delete the archive of a previous packed export: %s"), *StaleArchive);
+			return false;
+		}
+
+		if (!bWriteManifest)
+		{
+			// Likewise a blob-backed manifest of an earlier deduplicated export would be read instead of these files.
+			const FString StaleManifest = FPaths::Combine(TargetFolder, FAssetVaultFileManifest::FileName);
+			if (PlatformFile.FileExists(*StaleManifest) && !PlatformFile.DeleteFile(*StaleManifest))
+			{
+				UE_LOG(LogAssetVault, Error, TEXT("Failed to delete the file manifest of a previous export: %s"), *StaleManifest);
+				return false;
+			}
+			return true;
+		}
+
+		const FString FolderPrefix = TargetFolder + TEXT("/");
+
+		FAssetVaultFileManifest Manifest;
+		if (BlobStore.IsSet())
+		{
+			Manifest.BlobRoot = BlobStore->GetRoot();
+			FPaths::MakePathRelativeTo(Manifest.BlobRoot, *FolderPrefix);
+		}
+		Manifest.AddCopyResults(TargetFolder, Report);
+
+		const FAssetVaultExportDelta Delta = Manifest.Diff(PreviousManifest);
+		if (!PreviousManifest.IsBlobBacked())
+		{
+			for (const FString& RemovedFile : Delta.RemovedFiles)
+			{
+				PlatformFile.DeleteFile(*FPaths::Combine(TargetFolder, RemovedFile));
+			}
+		}
+
+		UE_LOG(LogAssetVault, Log, TEXT("Export delta for %s: %d added, %d updated, %d unchanged, %d removed"),
+			*TargetFolder, Delta.NumAdded, Delta.NumUpdated, Delta.NumUnchanged, Delta.RemovedFiles.Num());
+
+		if (!Manifest.Save(TargetFolder))
+		{
+			UE_LOG(LogAssetVault, Error, TEXT("Failed to save file manifest to: %s"), *TargetFolder);
+			return false;
+		}
+		return true;
+	}
+};
+
+struct FAssetVaultExportFile
+{
+	// Path relative to the export folder.
+	FString RelativePath;
+	// Physical file for loose and blob-backed exports, empty for archive entries.
+	FString SourceFile;
+	int32 ArchiveEntry = INDEX_NONE;
+	int64 Size = 0;
+	// Content hash when the storage records one (blobs, archive entries), empty for loose files.
+	FString Hash;
+};
+
+// Read access to one export, whatever its storage: loose files, a blob-backed manifest or a packed archive.
+class FAssetVaultExportSource
+{
+public:
+
+	explicit FAssetVaultExportSource(const FString& InSourceFolder)
+		: SourceFolder(InSourceFolder)
+	{
+		if (FAssetVaultArchive::Exists(SourceFolder))
+		{
+			Archive = MakeUnique<FAssetVaultArchiveReader>();
+			if (!Archive->Open(FAssetVaultArchive::GetPath(SourceFolder)))
+			{
+				// Never fall back to loose files here, a packed export has none.
+				Archive.Reset();
+				bCorruptArchive = true;
+			}
+			return;
+		}
+
+		bBlobBacked = FAssetVaultFileManifest::Exists(SourceFolder) && BlobManifest.Load(SourceFolder) && BlobManifest.IsBlobBacked();
+
+		const UAssetVaultSettings* Settings = GetDefault<UAssetVaultSettings>();
+		bAllowClone = Settings->bUseFileClones;
+		bAllowHardlink = bBlobBacked && Settings->bHardlinkVaultBlobs;
+	}
+
+	bool IsPacked() const { return Archive.IsValid(); }
+
+	// False when the export has an archive that cannot be read.
+	bool IsValid() const { return !bCorruptArchive; }
+
+	// Lists the package files of the export with one of the given extensions (".uasset" style), in one pass.
+	void Gather(const TArray<FString>& Extensions, TArray<FAssetVaultExportFile>& OutFiles) const
+	{
+		auto HasExtension = [&Extensions](const FString& Path)
+		{
+			for (const FString& Extension : Extensions)
+			{
+				if (Path.EndsWith(Extension))
+				{
+					return true;
+				}
+			}
+			return false;
+		};
+
+		if (bCorruptArchive)
+		{
+			return;
+		}
+
+		if (Archive)
+		{
+			const TArray<FAssetVaultArchiveEntry>& Entries = Archive->GetEntries();
+			for (int32 Index = 0; Index < Entries.Num(); ++Index)
+			{
+				if (HasExtension(Entries[Index].RelativePath))
+				{
+					OutFiles.Add({ Entries[Index].RelativePath, FString(), Index, Entries[Index].Size, Entries[Index].Hash });
+				}
+			}
+			return;
+		}
+
+		if (bBlobBacked)
+		{
+			for (const FAssetVaultFileEntry& Entry : BlobManifest.Files)
+			{
+				if (HasExtension(Entry.RelativePath))
+				{
+					OutFiles.Add({ Entry.RelativePath, BlobManifest.GetSourcePath(SourceFolder, Entry), INDEX_NONE, Entry.Size, Entry.Hash });
+				}
+			}
+			return;
+		}
+
+		FString SourcePrefix = SourceFolder;
+		FPaths::NormalizeDirectoryName(SourcePrefix);
+		SourcePrefix /= TEXT("");
+
+		FPlatformFileManager::Get().GetPlatformFile().IterateDirectoryStatRecursively(*SourceFolder,
+			[&](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData)
+			{
+				FString SourceFile = FilenameOrDirectory;
+				if (!StatData.bIsDirectory && HasExtension(SourceFile))
+				{
+					FPaths::NormalizeFilename(SourceFile);
+					if (SourceFile.StartsWith(SourcePrefix))
+					{
+						OutFiles.Add({ SourceFile.RightChop(SourcePrefix.Len()), SourceFile, INDEX_NONE, StatData.FileSize });
+					}
+					else
+					{
+						UE_LOG(LogAssetVault, Error, TEXT("Path mismatch:\n  Full:  %s\n  Prefix: %s"), *SourceFile, *SourcePrefix);
+					}
+				}
+				return true;
+			});
+	}
+
+	bool CopyTo(const FAssetVaultExportFile& File, const FString& DestPath, EAssetVaultCopyStrategy& OutStrategy) const
+	{
+		if (File.ArchiveEntry != INDEX_NONE)
+		{
+			OutStrategy = EAssetVaultCopyStrategy::Copy;
+			return Archive && Archive->ExtractEntry(File.ArchiveEntry, DestPath);
+		}
+		return FAssetVaultFileCopy::Copy(File.SourceFile, DestPath, bAllowClone, bAllowHardlink, OutStrategy);
+	}
+
+private:
+	FString SourceFolder;
+	FAssetVaultFileManifest BlobManifest;
+	bool bBlobBacked = false;
+	bool bAllowClone = false;
+	// Only blobs are linked, loose export files stay independent of the project copy.
+	bool bAllowHardlink = false;
+	bool bCorruptArchive = false;
+	TUniquePtr<FAssetVaultArchiveReader> Archive;
+};
+
+// Compares export files with what TargetFolder already holds. The target tree is listed once, only below
+// the top-level folders the export touches; files of equal size are then hashed in parallel.
+static void ClassifyImportFiles(const TArray<FAssetVaultExportFile>& Files, const FString& TargetFolder, TArray<EAssetVaultImportFileState>& OutStates)
+{
+	ASSETVAULT_SCOPE(ConflictCheck);
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	FString TargetPrefix = TargetFolder;
+	FPaths::NormalizeDirectoryName(TargetPrefix);
+	TargetPrefix /= TEXT("");
+
+	TSet<FString> TopLevelEntries;
+	for (const FAssetVaultExportFile& File : Files)
+	{
+		int32 SlashIndex = INDEX_NONE;
+		TopLevelEntries.Add(File.RelativePath.FindChar(TEXT('/'), SlashIndex) ? File.RelativePath.Left(SlashIndex) : File.RelativePath);
+	}
+
+	TMap<FString, int64> TargetSizes;
+	for (const FString& TopLevelEntry : TopLevelEntries)
+	{
+		const FString TopLevelPath = TargetPrefix + TopLevelEntry;
+		const FFileStatData TopLevelStat = PlatformFile.GetStatData(*TopLevelPath);
+		if (!TopLevelStat.bIsValid)
+		{
+			continue;
+		}
+		if (!TopLevelStat.bIsDirectory)
+		{
+			TargetSizes.Add(TopLevelEntry, TopLevelStat.FileSize);
+			continue;
+		}
+
+		PlatformFile.IterateDirectoryStatRecursively(*TopLevelPath, [&TargetSizes, &TargetPrefix](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData)
+		{
+			if (!StatData.bIsDirectory)
+			{
+				FString TargetFile = FilenameOrDirectory;
+				FPaths::NormalizeFilename(TargetFile);
+				if (TargetFile.StartsWith(TargetPrefix))
+				{
+					TargetSizes.Add(TargetFile.RightChop(TargetPrefix.Len()), StatData.FileSize);
+				}
+			}
+			return true;
+		});
+	}
+
+	OutStates.SetNumUninitialized(Files.Num());
+	TArray<int32> SameSize;
+	for (int32 Index = 0; Index < Files.Num(); ++Index)
+	{
+		const int64* TargetSize = TargetSizes.Find(Files[Index].RelativePath);
+		if (!TargetSize)
+		{
+			OutStates[Index] = EAssetVaultImportFileState::New;
+		}
+		else if (*TargetSize != Files[Index].Size)
+		{
+			OutStates[Index] = EAssetVaultImportFileState::Modified;
+		}
+		else
+		{
+			SameSize.Add(Index);
+		}
+	}
+
+	ParallelFor(SameSize.Num(), [&Files, &OutStates, &SameSize, &TargetPrefix](int32 SameSizeIndex)
+	{
+		const int32 Index = SameSize[SameSizeIndex];
+		const FAssetVaultExportFile& File = Files[Index];
+
+		FString SourceHash = File.Hash;
+		FString TargetHash;
+		const bool bHashed = (!SourceHash.IsEmpty() || FAssetVaultFileHash::HashFile(File.SourceFile, SourceHash))
+			&& FAssetVaultFileHash::HashFile(TargetPrefix + File.RelativePath, TargetHash);
+
+		OutStates[Index] = bHashed && SourceHash == TargetHash ? EAssetVaultImportFileState::Identical : EAssetVaultImportFileState::Modified;
+	}, EParallelForFlags::Unbalanced);
 }
 
 FString UAssetPackageManager::BuildExportPath(const FString& RootPath, const FAssetMainInfo& MainInfo)
@@ -73,43 +470,93 @@ bool UAssetPackageManager::ExportAssetToPackage(UObject* Asset, const FString& E
 {
 	if (!Asset)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Asset is null!"));
+		UE_LOG(LogAssetVault, Error, TEXT("Asset is null!"));
 		return false;
 	}
-	
-	FString TargetFolder = ExportDirectory;
-	FString AssetTypeStr = UEnum::GetValueAsString(ExportOptions.MainInfo.AssetType).Replace(TEXT("EAssetType::"), TEXT(""));
-	TargetFolder = FPaths::Combine(TargetFolder, AssetTypeStr);
 
-	if (!ExportOptions.MainInfo.CustomFolder.IsEmpty())
+	FString Message;
+	if (!ExportPackagesToFolder({ Asset->GetOutermost()->GetFName() }, ExportDirectory, MoveTemp(ExportOptions), Asset->GetName(), Message))
 	{
-		TargetFolder = FPaths::Combine(TargetFolder, ExportOptions.MainInfo.CustomFolder);
+		if (!Message.IsEmpty())
+		{
+			ShowEditorNotification(Message, false);
+		}
+		return false;
 	}
+	return true;
+}
 
-	TargetFolder = FPaths::Combine(TargetFolder, ExportOptions.MainInfo.Name);
+bool UAssetPackageManager::ExportPackagesToFolder(const TArray<FName>& RootPackages, const FString& ExportDirectory, FAssetExportOptions ExportOptions,
+	const FString& MetadataBaseName, FString& OutMessage, FAssetVaultExportProgress* Progress)
+{
+	ASSETVAULT_SCOPE(Export);
 
-	if (!ExportOptions.MainInfo.Version.IsEmpty())
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	if (AssetRegistry.IsLoadingAssets())
 	{
-		TargetFolder = FPaths::Combine(TargetFolder, ExportOptions.MainInfo.Version);
+		UE_LOG(LogAssetVault, Warning, TEXT("Asset Registry is still loading assets. Try again later."));
+		return false;
 	}
 
-	
-	if (!FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*TargetFolder))
+	const FString TargetFolder = BuildExportPath(ExportDirectory, ExportOptions.MainInfo);
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const bool bCreatedFolder = !PlatformFile.DirectoryExists(*TargetFolder);
+	if (!PlatformFile.CreateDirectoryTree(*TargetFolder))
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to create directory: %s"), *TargetFolder);
+		UE_LOG(LogAssetVault, Error, TEXT("Failed to create directory: %s"), *TargetFolder);
 		return false;
 	}
-	
-	if (!CopyAssetWithDependencies(Asset, TargetFolder))
+
+	FAssetVaultExportSession ExportSession(ExportDirectory, TargetFolder);
+	ExportSession.CopyEngine.SetProgress(Progress ? &Progress->Copy : nullptr);
+
+	// One closure for all roots: a dependency shared by several roots is visited and copied once.
+	FAssetVaultDependencyCache& DependencyCache = FAssetVaultDependencyCache::Get();
+	const int32 HitsBefore = DependencyCache.GetNumHits();
+	const int32 MissesBefore = DependencyCache.GetNumMisses();
+
+	TSet<FName> Packages;
+	DependencyCache.CollectClosure(RootPackages, FAssetVaultDependencyScope::FromSettings(), Packages,
+		Progress ? &Progress->Copy.bCancel : nullptr, Progress ? &Progress->PackagesResolved : nullptr);
+
+	ASSETVAULT_COUNT(PackagesResolved, Packages.Num());
+	UE_LOG(LogAssetVault, Log, TEXT("Resolved %d packages from %d roots (%d cached, %d registry lookups)"),
+		Packages.Num(), RootPackages.Num(), DependencyCache.GetNumHits() - HitsBefore, DependencyCache.GetNumMisses() - MissesBefore);
+
+	FAssetVaultCopyReport CopyReport;
+	if (!Progress || !Progress->IsCancelled())
+	{
+		if (Progress)
+		{
+			Progress->Phase = EAssetVaultExportPhase::Copying;
+		}
+		CopyPackages(Packages, TargetFolder, ExportSession.CopyEngine, CopyReport);
+	}
+
+	if (Progress && Progress->IsCancelled())
 	{
+		ExportSession.Discard(TargetFolder, CopyReport, bCreatedFolder);
+		UE_LOG(LogAssetVault, Log, TEXT("Export to %s cancelled"), *TargetFolder);
+		OutMessage = TEXT("Export cancelled.");
 		return false;
 	}
 
+	if (CopyReport.HasFailures())
+	{
+		OutMessage = FString::Printf(TEXT("Export failed: %d file(s) could not be copied."), CopyReport.NumFailed);
+		return false;
+	}
+
+	if (Progress)
+	{
+		Progress->Phase = EAssetVaultExportPhase::Finalizing;
+	}
+
 	if (ExportOptions.MainInfo.EngineVersion.IsEmpty())
 	{
 		FEngineVersion Ver = FEngineVersion::Current();
-		FString EngineVerShort = FString::Printf(TEXT("%d.%d"), Ver.GetMajor(), Ver.GetMinor());
-		ExportOptions.MainInfo.EngineVersion = EngineVerShort;
+		ExportOptions.MainInfo.EngineVersion = FString::Printf(TEXT("%d.%d"), Ver.GetMajor(), Ver.GetMinor());
 	}
 	
 	TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
@@ -121,7 +568,6 @@ bool UAssetPackageManager::ExportAssetToPackage(UObject* Asset, const FString& E
 	JsonObject->SetStringField(TEXT("VersionComment"), ExportOptions.MainInfo.VersionComment);
 	JsonObject->SetStringField(TEXT("CustomFolder"), ExportOptions.MainInfo.CustomFolder);
 
-	
 	FString RelativePath = TargetFolder;
 	FPaths::MakePathRelativeTo(RelativePath, *ExportDirectory);
 	const FString RootPrefix = TEXT("ResourceAssets/");
@@ -130,8 +576,8 @@ bool UAssetPackageManager::ExportAssetToPackage(UObject* Asset, const FString& E
 		RelativePath = RelativePath.RightChop(RootPrefix.Len());
 	}
 	JsonObject->SetStringField(TEXT("RelativeExportPath"), RelativePath);
+	ExportOptions.MainInfo.RelativeExportPath = RelativePath;
 
-	
 	TArray<TSharedPtr<FJsonValue>> TagsJson;
 	for (const FString& Tag : ExportOptions.AdditionalInfo.Tags)
 	{
@@ -139,237 +585,118 @@ bool UAssetPackageManager::ExportAssetToPackage(UObject* Asset, const FString& E
 	}
 	JsonObject->SetArrayField(TEXT("Tags"), TagsJson);
 
-	
-	TArray<FString> FoundUAssetFiles;
-	IFileManager::Get().FindFilesRecursive(
-		FoundUAssetFiles,
-		*TargetFolder,
-		TEXT("*.uasset"),
-		true, false
-	);
-	
 	TArray<TSharedPtr<FJsonValue>> AssetNamesJson;
 	ExportOptions.MainInfo.ExportedAssetNames.Empty();
+	CollectExportedAssetNames(CopyReport, ExportOptions.MainInfo.ExportedAssetNames);
 
-	for (const FString& FilePath : FoundUAssetFiles)
+	for (const FString& FileName : ExportOptions.MainInfo.ExportedAssetNames)
 	{
-		const FString FileName = FPaths::GetBaseFilename(FilePath);
 		AssetNamesJson.Add(MakeShared<FJsonValueString>(FileName));
-		ExportOptions.MainInfo.ExportedAssetNames.Add(FileName);
 	}
 
 	JsonObject->SetArrayField(TEXT("Assets"), AssetNamesJson);
 
-	
+	ExportOptions.AdditionalInfo.PreviewImagePaths.Empty();
+	FAssetVaultPreviewFile::Write(TargetFolder, RootPackages, ExportOptions.AdditionalInfo.PreviewImagePaths);
+
+	TArray<TSharedPtr<FJsonValue>> PreviewsJson;
+	for (const FString& PreviewName : ExportOptions.AdditionalInfo.PreviewImagePaths)
+	{
+		PreviewsJson.Add(MakeShared<FJsonValueString>(PreviewName));
+	}
+	JsonObject->SetArrayField(TEXT("PreviewImages"), PreviewsJson);
+	JsonObject->SetStringField(TEXT("ExportedAt"), FDateTime::UtcNow().ToIso8601());
+	JsonObject->SetArrayField(TEXT("History"), FAssetVaultMetadata::CollectHistory(TargetFolder, GetDefault<UAssetVaultSettings>()->MaxMetadataHistory));
+
 	FString OutputString;
 	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
 	if (!FJsonSerializer::Serialize(JsonObject, Writer))
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to serialize metadata to JSON."));
+		UE_LOG(LogAssetVault, Error, TEXT("Failed to serialize metadata to JSON."));
 		return false;
 	}
-	
-	const FString AssetName = Asset->GetName();
-	const FString HashBase = AssetName + AssetTypeStr + FDateTime::Now().ToString();
-	const uint32 SymbolCode = FCrc::StrCrc32(*HashBase);
-	FString FileName = FString::Printf(TEXT("%s_%s_%X.json"), *AssetName, *AssetTypeStr, SymbolCode);
-	FPaths::MakeValidFileName(FileName);
-	const FString MetadataPath = FPaths::Combine(TargetFolder, FileName);
-	
-	if (!FFileHelper::SaveStringToFile(OutputString, *MetadataPath))
-	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to save metadata to: %s"), *MetadataPath);
-		return false;
-	}
-
-	UE_LOG(LogTemp, Log, TEXT("Asset and metadata successfully exported to: %s"), *TargetFolder);
-	return true;
-}
 
-bool UAssetPackageManager::CopyAssetWithDependencies(UObject* Asset, const FString& TargetDirectory)
-{
-	if (!Asset)
+	if (!ExportSession.Finalize(TargetFolder, CopyReport, OutputString))
 	{
-		UE_LOG(LogTemp, Error, TEXT("Asset is null."));
 		return false;
 	}
-
-	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
-
-	if (AssetRegistry.IsLoadingAssets())
+	
+	if (!FAssetVaultMetadata::SaveToExportFolder(TargetFolder, FAssetVaultMetadata::MakeFileName(MetadataBaseName, ExportOptions.MainInfo.AssetType), OutputString, ExportOptions))
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Asset Registry is still loading assets. Try again later."));
 		return false;
 	}
 
-	TSet<FName> AllPackagesToCopy;
-	TQueue<FName> PackagesToProcess;
+	UE_LOG(LogAssetVault, Log, TEXT("Assets and metadata successfully exported to: %s"), *TargetFolder);
+	return true;
+}
 
-	FString AssetPackagePath = Asset->GetOutermost()->GetName();
-	FName RootPackageName = FName(*AssetPackagePath);
+bool UAssetPackageManager::CopyPackages(const TSet<FName>& Packages, const FString& TargetDirectory, const FAssetVaultCopyEngine& CopyEngine, FAssetVaultCopyReport& OutReport)
+{
+	const FString ContentDir = FPaths::ProjectContentDir();
 
-	PackagesToProcess.Enqueue(RootPackageName);
-	AllPackagesToCopy.Add(RootPackageName);
+	TArray<FAssetVaultCopyJob> Jobs;
+	Jobs.Reserve(Packages.Num());
 
-	while (!PackagesToProcess.IsEmpty())
+	for (const FName& PackageName : Packages)
 	{
-		FName CurrentPackageName;
-		PackagesToProcess.Dequeue(CurrentPackageName);
-
-		FAssetIdentifier Identifier(CurrentPackageName);
-
-		TArray<FAssetDependency> Dependencies;
-		UE::AssetRegistry::FDependencyQuery Query;
-		Query.Required = UE::AssetRegistry::EDependencyProperty::Hard;
-
-		AssetRegistry.GetDependencies(Identifier, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, Query);
-
-		for (const FAssetDependency& Dep : Dependencies)
+		const FString PackageNameStr = PackageName.ToString();
+		if (FPackageName::IsScriptPackage(PackageNameStr))
 		{
-			FName DepPackageName = Dep.AssetId.PackageName;
-			if (!AllPackagesToCopy.Contains(DepPackageName))
-			{
-				AllPackagesToCopy.Add(DepPackageName);
-				PackagesToProcess.Enqueue(DepPackageName);
-			}
+			continue;
 		}
-	}
-
-	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-	TArray<FString> ExtensionsToCheck = { TEXT("uasset"), TEXT("uexp"), TEXT("ubulk"), TEXT("map") };
-
-	for (const FName& PackageName : AllPackagesToCopy)
-	{
-		FString PackageFilePath = FPackageName::LongPackageNameToFilename(PackageName.ToString(), TEXT(".uasset"));
 
-		if (!FPaths::FileExists(PackageFilePath))
+		FString PackageBasePath;
+		if (!FPackageName::TryConvertLongPackageNameToFilename(PackageNameStr, PackageBasePath))
 		{
-			UE_LOG(LogTemp, Warning, TEXT("Main .uasset file does not exist: %s"), *PackageFilePath);
+			UE_LOG(LogAssetVault, Warning, TEXT("Cannot resolve package file for: %s"), *PackageNameStr);
 			continue;
 		}
 
-		FString RelativePath = PackageFilePath;
-		FPaths::MakePathRelativeTo(RelativePath, *FPaths::ProjectContentDir());
+		FString RelativePath = PackageBasePath;
+		FPaths::MakePathRelativeTo(RelativePath, *ContentDir);
+
+		Jobs.Add(FAssetVaultCopyJob::Package(PackageBasePath, FPaths::Combine(TargetDirectory, RelativePath)));
+	}
 
-		FString TargetPath = FPaths::Combine(TargetDirectory, RelativePath);
-		FString TargetFolder = FPaths::GetPath(TargetPath);
+	OutReport = CopyEngine.Run(Jobs);
 
-		if (!PlatformFile.DirectoryExists(*TargetFolder))
+	for (const FAssetVaultCopyResult& Result : OutReport.Results)
+	{
+		if (Result.Status == EAssetVaultCopyStatus::Failed)
 		{
-			PlatformFile.CreateDirectoryTree(*TargetFolder);
+			UE_LOG(LogAssetVault, Error, TEXT("Failed to copy %s to %s"), *Result.SourceFile, *Result.TargetFile);
 		}
-
-		for (const FString& Extension : ExtensionsToCheck)
+		else if (Result.Status == EAssetVaultCopyStatus::Missing)
 		{
-			FString SourceFile = FPaths::ChangeExtension(PackageFilePath, Extension);
-			FString TargetFile = FPaths::ChangeExtension(TargetPath, Extension);
-
-			if (FPaths::FileExists(SourceFile))
-			{
-				if (!PlatformFile.CopyFile(*TargetFile, *SourceFile))
-				{
-					UE_LOG(LogTemp, Error, TEXT("Failed to copy %s to %s"), *SourceFile, *TargetFile);
-				}
-			}
+			UE_LOG(LogAssetVault, Warning, TEXT("Main package file does not exist: %s"), *Result.SourceFile);
 		}
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("Copied %d packages (with dependencies) to %s"), AllPackagesToCopy.Num(), *TargetDirectory);
-	return true;
+	UE_LOG(LogAssetVault, Log, TEXT("Copied %d files (%lld bytes, %d unchanged) from %d packages to %s in %.2fs using %d workers, %d failed (%s)"),
+		OutReport.NumCopied, OutReport.TotalBytes, OutReport.NumUnchanged, Jobs.Num(), *TargetDirectory, OutReport.Seconds, CopyEngine.GetNumWorkers(), OutReport.NumFailed,
+		*OutReport.DescribeStrategies());
+
+	return !OutReport.HasFailures();
 }
 
 TArray<FAssetExportOptions> UAssetPackageManager::LoadAllAssetDataFromDirectory(const FString& DirectoryPath)
 {
 	TArray<FAssetExportOptions> Results;
 
-	IFileManager& FileManager = IFileManager::Get();
-
-	
-	TArray<FString> SubFolders;
-	FileManager.FindFilesRecursive(SubFolders, *DirectoryPath, TEXT("*"), false, true);
+	const bool bUseCatalog = GetDefault<UAssetVaultSettings>()->bUseVaultCatalog;
 
-	for (const FString& FolderPath : SubFolders)
+	FAssetVaultCatalog Catalog(DirectoryPath);
+	if (bUseCatalog)
 	{
-		
-		TArray<FString> JsonFiles;
-		FileManager.FindFiles(JsonFiles, *(FolderPath / TEXT("*.json")), true, false);
-
-		for (const FString& FileName : JsonFiles)
-		{
-			FString FullPath = FolderPath / FileName;
-			FString FileContents;
-
-			if (!FFileHelper::LoadFileToString(FileContents, *FullPath))
-			{
-				UE_LOG(LogTemp, Warning, TEXT("Failed to read file: %s"), *FullPath);
-				continue;
-			}
-
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FileContents);
-			TSharedPtr<FJsonObject> JsonObject;
-
-			if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
-			{
-				UE_LOG(LogTemp, Warning, TEXT("Failed to parse JSON in file: %s"), *FullPath);
-				continue;
-			}
-
-			FAssetExportOptions Options;
-
-			
-			Options.MainInfo.Name = JsonObject->GetStringField(TEXT("Name"));
-
-			FString AssetTypeStr = JsonObject->GetStringField(TEXT("AssetType"));
-			AssetTypeStr = AssetTypeStr.Replace(TEXT("EAssetType::"), TEXT(""));
-			Options.MainInfo.AssetType = StringToAssetType(AssetTypeStr);
-			Options.MainInfo.Description = JsonObject->GetStringField(TEXT("Description"));
-			Options.MainInfo.EngineVersion = JsonObject->GetStringField(TEXT("EngineVersion"));
-			Options.MainInfo.CustomFolder = JsonObject->GetStringField(TEXT("CustomFolder"));
-			Options.MainInfo.RelativeExportPath = JsonObject->GetStringField(TEXT("RelativeExportPath"));
-
-			if (JsonObject->HasField(TEXT("Version")))
-			{
-				Options.MainInfo.Version = JsonObject->GetStringField(TEXT("Version"));
-			}
-			if (JsonObject->HasField(TEXT("VersionComment")))
-			{
-				Options.MainInfo.VersionComment = JsonObject->GetStringField(TEXT("VersionComment"));
-			}
-
-			else
-			{
-				Options.MainInfo.Version = TEXT("1.0");
-			}
-
-			
-			TArray<TSharedPtr<FJsonValue>> TagsArray = JsonObject->GetArrayField(TEXT("Tags"));
-			for (const TSharedPtr<FJsonValue>& TagValue : TagsArray)
-			{
-				if (TagValue->Type == EJson::String)
-				{
-					Options.AdditionalInfo.Tags.Add(TagValue->AsString());
-				}
-			}
-
-		
-
-			
-			if (JsonObject->HasField(TEXT("Assets")))
-			{
-				const TArray<TSharedPtr<FJsonValue>> AssetsArray = JsonObject->GetArrayField(TEXT("Assets"));
-				for (const TSharedPtr<FJsonValue>& Value : AssetsArray)
-				{
-					if (Value->Type == EJson::String)
-					{
-						Options.MainInfo.ExportedAssetNames.Add(Value->AsString());
-					}
-				}
-			}
+		Catalog.Load();
+	}
 
-			Results.Add(Options);
-		}
+	if (Catalog.Refresh() && bUseCatalog)
+	{
+		Catalog.Save();
 	}
 
+	Catalog.GetAllEntries(Results);
 	return Results;
 }
 
@@ -378,7 +705,7 @@ int32 UAssetPackageManager::GetAssetTypeMaxIndex()
 	const UEnum* EnumPtr = StaticEnum<EAssetType>();
 	if (!EnumPtr)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Не удалось получить StaticEnum<EAssetType>"));
+		UE_LOG(LogAssetVault, Error, TEXT("Не удалось получить StaticEnum<EAssetType>"));
 		return 0;
 	}
 	return EnumPtr->GetMaxEnumValue(); 
@@ -386,24 +713,29 @@ int32 UAssetPackageManager::GetAssetTypeMaxIndex()
 
 TArray<FAssetExportOptions> UAssetPackageManager::FilterAndSortAssets(const TArray<FAssetExportOptions>& Assets,EAssetType FilterType)
 {
-	TArray<FAssetExportOptions> FilteredAssets;
-
-	for (const FAssetExportOptions& Asset : Assets)
+	// Sort indices instead of the structs, each match is copied exactly once.
+	TArray<int32> Order;
+	Order.Reserve(Assets.Num());
+	for (int32 Index = 0; Index < Assets.Num(); ++Index)
 	{
-		
-		if (FilterType != EAssetType::All && Asset.MainInfo.AssetType != FilterType)
+		if (FilterType == EAssetType::All || Assets[Index].MainInfo.AssetType == FilterType)
 		{
-			continue;
+			Order.Add(Index);
 		}
-
-		FilteredAssets.Add(Asset);
 	}
-	
-	FilteredAssets.Sort([](const FAssetExportOptions& A, const FAssetExportOptions& B)
+
+	Order.StableSort([&Assets](int32 A, int32 B)
 	{
-		return A.MainInfo.Name < B.MainInfo.Name;
+		return Assets[A].MainInfo.Name < Assets[B].MainInfo.Name;
 	});
 
+	TArray<FAssetExportOptions> FilteredAssets;
+	FilteredAssets.Reserve(Order.Num());
+	for (const int32 Index : Order)
+	{
+		FilteredAssets.Add(Assets[Index]);
+	}
+
 	return FilteredAssets;
 }
 
@@ -418,7 +750,7 @@ void UAssetPackageManager::OpenFolderInExplorer(const FString& BaseDirectory, FS
 	
 	IFileManager::Get().MakeDirectory(*FinalPath, true);
 
-	UE_LOG(LogTemp, Display, TEXT("Opening folder: %s"), *FinalPath);
+	UE_LOG(LogAssetVault, Verbose, TEXT("Opening folder: %s"), *FinalPath);
 	
 	const FString ExplorerArgs = FString::Printf(TEXT("\"%s\""), *FinalPath);
 	FPlatformProcess::CreateProc(TEXT("explorer.exe"), *ExplorerArgs, true, false, false, nullptr, 0, nullptr, nullptr);
@@ -429,7 +761,7 @@ bool UAssetPackageManager::OpenFolderDialog(FString& OutFolderPath)
 	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
 	if (!DesktopPlatform)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Desktop platform is unavailable."));
+		UE_LOG(LogAssetVault, Error, TEXT("Desktop platform is unavailable."));
 		return false;
 	}
 
@@ -452,20 +784,23 @@ bool UAssetPackageManager::OpenFolderDialog(FString& OutFolderPath)
 
 bool UAssetPackageManager::ImportAssetFolderToProject(const FString& DefaultDirectory, const FString& RelativeExportPath, const FString& TargetSubfolder, bool bForceOverwrite)
 {
-    const FString SourceFolder = FPaths::Combine(DefaultDirectory, RelativeExportPath);
+    FAssetVaultImportResult Result;
+    return ImportPackagesFromFolder(DefaultDirectory, RelativeExportPath, TargetSubfolder, bForceOverwrite, Result);
+}
+
+bool UAssetPackageManager::ImportPackagesFromFolder(const FString& DefaultDirectory, const FString& RelativeExportPath, const FString& TargetSubfolder,
+    bool bForceOverwrite, FAssetVaultImportResult& OutResult)
+{
+    ASSETVAULT_SCOPE(Import);
+
+    OutResult = FAssetVaultImportResult();
 
-    UE_LOG(LogTemp, Warning, TEXT("----------------------------------------"));
-    UE_LOG(LogTemp, Warning, TEXT("VAULT IMPORT BEGIN"));
-    UE_LOG(LogTemp, Warning, TEXT("----------------------------------------"));
-    UE_LOG(LogTemp, Warning, TEXT("[Vault] Step 1: Validate input paths and directories"));
-    UE_LOG(LogTemp, Warning, TEXT("[Vault] RelativeExportPath: %s"), *RelativeExportPath);
-    UE_LOG(LogTemp, Warning, TEXT("[Vault] DefaultDirectory:   %s"), *DefaultDirectory);
-    UE_LOG(LogTemp, Warning, TEXT("[Vault] SourceFolder (combined): %s"), *SourceFolder);
+    const FString SourceFolder = FPaths::Combine(DefaultDirectory, RelativeExportPath);
 
     if (TargetSubfolder.Contains(TEXT("..")))
     {
         ShowEditorNotification(TEXT("Error: Invalid target subfolder path."), false);
-        UE_LOG(LogTemp, Error, TEXT("[Vault] Invalid TargetSubfolder: %s"), *TargetSubfolder);
+        UE_LOG(LogAssetVault, Error, TEXT("Invalid import target subfolder: %s"), *TargetSubfolder);
         return false;
     }
 
@@ -474,169 +809,207 @@ bool UAssetPackageManager::ImportAssetFolderToProject(const FString& DefaultDire
         ? ContentDir
         : FPaths::ConvertRelativePathToFull(FPaths::Combine(ContentDir, TargetSubfolder));
 
-    UE_LOG(LogTemp, Warning, TEXT("[Vault] TargetSubfolder: %s"), *TargetSubfolder);
-    UE_LOG(LogTemp, Warning, TEXT("[Vault] Project ContentDir: %s"), *ContentDir);
-    UE_LOG(LogTemp, Warning, TEXT("[Vault] TargetFolder (resolved): %s"), *TargetFolder);
+    UE_LOG(LogAssetVault, Log, TEXT("Import %s -> %s"), *SourceFolder, *TargetFolder);
 
     if (!FPaths::DirectoryExists(SourceFolder))
     {
         ShowEditorNotification(TEXT("Error: Source folder not found."), false);
-        UE_LOG(LogTemp, Error, TEXT("[Vault] Source folder does not exist: %s"), *SourceFolder);
+        UE_LOG(LogAssetVault, Error, TEXT("Import source folder does not exist: %s"), *SourceFolder);
         return false;
     }
 
-    UE_LOG(LogTemp, Warning, TEXT("\n-------- Step 2: Create target folder --------"));
     IFileManager& FileManager = IFileManager::Get();
-    const bool bMadeRootDir = FileManager.MakeDirectory(*TargetFolder, true);
-    UE_LOG(LogTemp, Display, TEXT("[Vault] Created TargetFolder: %s => %s"), *TargetFolder, bMadeRootDir ? TEXT("OK") : TEXT("EXISTED"));
+    FileManager.MakeDirectory(*TargetFolder, true);
+
+    FAssetVaultJournal& Journal = FAssetVaultJournal::Get();
+    const uint32 JournalId = Journal.BeginOperation(TEXT("Import"), SourceFolder);
 
     TArray<FString> CopiedFiles;
-    TArray<UObject*> ImportedAssets;
-    const TArray<FString> Extensions = { TEXT("uasset"), TEXT("uexp"), TEXT("ubulk") };
+    TArray<FString> CopiedPackageFiles;
+    TArray<FName> ImportedPackages;
+    FAssetVaultCopyReport CopyStats;
 
-    UE_LOG(LogTemp, Warning, TEXT("\n-------- Step 3: Copy asset files --------"));
-    for (const FString& Ext : Extensions)
+    const FAssetVaultExportSource ExportSource(SourceFolder);
+    if (!ExportSource.IsValid())
     {
-        TArray<FString> FoundFiles;
-        FileManager.FindFilesRecursive(FoundFiles, *SourceFolder, *(FString("*.") + Ext), true, false);
-        UE_LOG(LogTemp, Display, TEXT("[Vault] Found %d files with extension .%s"), FoundFiles.Num(), *Ext);
+        ShowEditorNotification(TEXT("Import failed: the export's archive is corrupt."), false);
+        UE_LOG(LogAssetVault, Error, TEXT("Import failed: archive is corrupt: %s"), *FAssetVaultArchive::GetPath(SourceFolder));
+        return false;
+    }
 
-        for (const FString& SourceFile : FoundFiles)
+    // Editors open on an asset that is about to be replaced are closed before its file is overwritten.
+    UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+    TMap<FString, UObject*> OpenAssetsByPackage;
+    for (UObject* OpenAsset : AssetEditorSubsystem->GetAllEditedAssets())
+    {
+        if (OpenAsset)
         {
-            FString SourcePrefix = FPaths::Combine(DefaultDirectory, RelativeExportPath);
-            FPaths::NormalizeFilename(SourcePrefix);
-            FPaths::CollapseRelativeDirectories(SourcePrefix);
+            OpenAssetsByPackage.FindOrAdd(OpenAsset->GetOutermost()->GetName(), OpenAsset);
+        }
+    }
 
-            FString FullSource = SourceFile;
-            FPaths::NormalizeFilename(FullSource);
-            FPaths::CollapseRelativeDirectories(FullSource);
+    double PhaseStart = FPlatformTime::Seconds();
+    auto EndPhase = [&PhaseStart]()
+    {
+        const double Now = FPlatformTime::Seconds();
+        const double Milliseconds = (Now - PhaseStart) * 1000.0;
+        PhaseStart = Now;
+        return Milliseconds;
+    };
+
+    TArray<FAssetVaultExportFile> FoundFiles;
+    ExportSource.Gather(FAssetVaultCopyEngine::GetPackageExtensions(), FoundFiles);
+
+    TArray<EAssetVaultImportFileState> FileStates;
+    ClassifyImportFiles(FoundFiles, TargetFolder, FileStates);
+    int32 NumByState[3] = { 0, 0, 0 };
+    for (EAssetVaultImportFileState State : FileStates)
+    {
+        ++NumByState[static_cast<int32>(State)];
+    }
+    const int32 NumIdentical = NumByState[static_cast<int32>(EAssetVaultImportFileState::Identical)];
+    OutResult.NumNew = NumByState[static_cast<int32>(EAssetVaultImportFileState::New)];
+    OutResult.NumIdentical = NumIdentical;
+    OutResult.NumModified = NumByState[static_cast<int32>(EAssetVaultImportFileState::Modified)];
+    UE_LOG(LogAssetVault, Log, TEXT("Import classify: %d files (%d new, %d identical, %d modified) in %.1f ms"), FoundFiles.Num(),
+        NumByState[static_cast<int32>(EAssetVaultImportFileState::New)], NumIdentical,
+        NumByState[static_cast<int32>(EAssetVaultImportFileState::Modified)], EndPhase());
+
+    TSet<FString> EnsuredDirectories;
+    int32 NumSkippedExisting = 0;
+    int64 BytesCopied = 0;
+
+    for (int32 FileIndex = 0; FileIndex < FoundFiles.Num(); ++FileIndex)
+    {
+        const FAssetVaultExportFile& FoundFile = FoundFiles[FileIndex];
+        const FString Ext = FPaths::GetExtension(FoundFile.RelativePath);
 
-            if (!FullSource.StartsWith(SourcePrefix))
-            {
-                UE_LOG(LogTemp, Error, TEXT("[Vault] Path mismatch:\n  Full:  %s\n  Prefix: %s"), *FullSource, *SourcePrefix);
-                continue;
-            }
+        // Byte-identical files are neither copied, rescanned nor reloaded.
+        if (FileStates[FileIndex] == EAssetVaultImportFileState::Identical)
+        {
+            Journal.Add(JournalId, EAssetVaultJournalAction::SkippedIdentical, FoundFile.RelativePath);
+            ASSETVAULT_COUNT(FilesUnchanged, 1);
+            continue;
+        }
 
-            FString RelativePath = FullSource.RightChop(SourcePrefix.Len() + 1);
-            const FString DestPath = FPaths::Combine(TargetFolder, RelativePath);
-            const FString DestDir = FPaths::GetPath(DestPath);
+        const FString& RelativePath = FoundFile.RelativePath;
+        const FString DestPath = FPaths::Combine(TargetFolder, RelativePath);
 
-            const bool bMadeDir = FileManager.MakeDirectory(*DestDir, true);
-            UE_LOG(LogTemp, Display, TEXT("[Vault] Ensured directory: %s => %s"), *DestDir, bMadeDir ? TEXT("CREATED") : TEXT("EXISTED"));
+        const bool bReplacing = FileStates[FileIndex] == EAssetVaultImportFileState::Modified;
+        if (bReplacing && !bForceOverwrite)
+        {
+            Journal.Add(JournalId, EAssetVaultJournalAction::SkippedExisting, RelativePath);
+            ++NumSkippedExisting;
+            continue;
+        }
 
-            UE_LOG(LogTemp, Display, TEXT("[Vault] Copying asset:"));
-            UE_LOG(LogTemp, Display, TEXT("  FROM: %s"), *SourceFile);
-            UE_LOG(LogTemp, Display, TEXT("  TO:   %s"), *DestPath);
+        FString DestDir = FPaths::GetPath(DestPath);
+        if (!EnsuredDirectories.Contains(DestDir))
+        {
+            FileManager.MakeDirectory(*DestDir, true);
+            EnsuredDirectories.Add(MoveTemp(DestDir));
+        }
 
-            int64 BytesCopied = 0;
+        FString DestRelPath = DestPath;
+        FPaths::MakePathRelativeTo(DestRelPath, *FPaths::ProjectContentDir());
+        const FString PackageName = TEXT("/Game/") + FPaths::ChangeExtension(DestRelPath, TEXT(""));
 
-            if (FPaths::FileExists(DestPath))
+        // A loaded package keeps its files open, on Windows they cannot be replaced until its loader is detached.
+        if (bReplacing)
+        {
+            if (UPackage* Package = FindPackage(nullptr, *PackageName))
             {
-                if (!bForceOverwrite)
-                {
-                    UE_LOG(LogTemp, Warning, TEXT("[Vault] Skipped (already exists): %s"), *DestPath);
-                    continue;
-                }
-                else
+                UObject* OpenAsset = nullptr;
+                if (OpenAssetsByPackage.RemoveAndCopyValue(PackageName, OpenAsset))
                 {
-                    UE_LOG(LogTemp, Warning, TEXT("[Vault] Replacing existing file: %s"), *DestPath);
+                    AssetEditorSubsystem->CloseAllEditorsForAsset(OpenAsset);
+                    Journal.Add(JournalId, EAssetVaultJournalAction::ClosedEditor, PackageName);
                 }
+                ResetLoaders(Package);
             }
+        }
 
-            BytesCopied = FileManager.Copy(*DestPath, *SourceFile, true, true);
+        EAssetVaultCopyStrategy Strategy = EAssetVaultCopyStrategy::None;
+        const bool bCopied = ExportSource.CopyTo(FoundFile, DestPath, Strategy);
 
-            if (BytesCopied <= 0 && bForceOverwrite && FPaths::FileExists(SourceFile))
+        if (bCopied)
+        {
+            Journal.Add(JournalId, bReplacing ? EAssetVaultJournalAction::Replaced : EAssetVaultJournalAction::Copied, RelativePath, FoundFile.Size, Strategy);
+            CopiedFiles.Add(DestPath);
+            BytesCopied += FoundFile.Size;
+            if (bReplacing)
             {
-                UE_LOG(LogTemp, Warning, TEXT("[Vault] Fallback: trying overwrite with memory buffer..."));
-
-                TArray<uint8> FileData;
-                if (FFileHelper::LoadFileToArray(FileData, *SourceFile))
-                {
-                    if (FFileHelper::SaveArrayToFile(FileData, *DestPath))
-                    {
-                        BytesCopied = FileData.Num();
-                        UE_LOG(LogTemp, Display, TEXT("[Vault] Fallback write succeeded (%lld bytes): %s"), BytesCopied, *DestPath);
-                    }
-                    else
-                    {
-                        UE_LOG(LogTemp, Error, TEXT("[Vault] Fallback write failed: %s"), *DestPath);
-                    }
-                }
-                else
-                {
-                    UE_LOG(LogTemp, Error, TEXT("[Vault] Fallback read failed: %s"), *SourceFile);
-                }
+                ++OutResult.NumReplaced;
             }
-
-            if (BytesCopied > 0)
+            else
             {
-                UE_LOG(LogTemp, Display, TEXT("[Vault] Copied successfully (%lld bytes): %s"), BytesCopied, *DestPath);
-                CopiedFiles.Add(DestPath);
-
-                if (Ext == TEXT("uasset"))
-                {
-                    FString AssetName = FPaths::GetBaseFilename(DestPath);
-                    TArray<UObject*> OpenAssets = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->GetAllEditedAssets();
-                    for (UObject* OpenAsset : OpenAssets)
-                    {
-                        if (OpenAsset && OpenAsset->GetName() == AssetName)
-                        {
-                            UPackage* Pkg = OpenAsset->GetOutermost();
-                            ResetLoaders(Pkg);
-                            Pkg->ClearFlags(RF_Standalone | RF_Public);
-                            GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->CloseAllEditorsForAsset(OpenAsset);
-                            UE_LOG(LogTemp, Warning, TEXT("[Vault] Closed editor and cleared memory for: %s"), *AssetName);
-                            break;
-                        }
-                    }
-
-                    FString DestRelPath = DestPath;
-                    FPaths::MakePathRelativeTo(DestRelPath, *FPaths::ProjectContentDir());
-                    const FString ObjectPath = "/Game/" + FPaths::ChangeExtension(DestRelPath, TEXT(""));
-                    UObject* ImportedAsset = LoadObject<UObject>(nullptr, *ObjectPath);
-                    if (ImportedAsset)
-                    {
-                        ImportedAssets.Add(ImportedAsset);
-                    }
-                }
+                ++OutResult.NumCopied;
             }
-            else
+            ASSETVAULT_COUNT(FilesCopied, 1);
+            ASSETVAULT_COUNT_BYTES(BytesCopied, FoundFile.Size);
+            ++CopyStats.NumByStrategy[static_cast<int32>(Strategy)];
+
+            // Loading waits until every file is copied and the registry has seen them all.
+            if (Ext == TEXT("uasset") || Ext == TEXT("umap"))
             {
-                UE_LOG(LogTemp, Error, TEXT("[Vault] Copy failed: %s"), *DestPath);
+                CopiedPackageFiles.Add(DestPath);
+                ImportedPackages.Add(FName(*PackageName));
             }
         }
+        else
+        {
+            Journal.Add(JournalId, EAssetVaultJournalAction::Failed, RelativePath);
+            ++CopyStats.NumFailed;
+        }
     }
 
-    if (CopiedFiles.Num() == 0)
+    OutResult.NumSkippedExisting = NumSkippedExisting;
+    OutResult.NumFailed = CopyStats.NumFailed;
+    OutResult.BytesCopied = BytesCopied;
+
+    UE_LOG(LogAssetVault, Log, TEXT("Import copy: %d copied (%s), %d skipped as existing, %.1f MB in %.1f ms"),
+        CopiedFiles.Num(), *CopyStats.DescribeStrategies(), NumSkippedExisting, BytesCopied / (1024.0 * 1024.0), EndPhase());
+    if (CopyStats.NumFailed > 0)
     {
-        ShowEditorNotification(TEXT("Import failed: No files copied."), false);
-        UE_LOG(LogTemp, Error, TEXT("[Vault] Nothing copied — returning FALSE."));
-        return false;
+        UE_LOG(LogAssetVault, Error, TEXT("Import copy: %d file(s) could not be copied, run AssetVault.DumpJournal for the list"), CopyStats.NumFailed);
     }
 
-    UE_LOG(LogTemp, Warning, TEXT("\n-------- Step 4: Rescan Asset Registry --------"));
-    TSet<FString> UniquePaths;
-    for (const FString& File : CopiedFiles)
+    if (CopiedFiles.Num() == 0 && NumIdentical > 0 && NumIdentical == FoundFiles.Num())
     {
-        if (FPaths::GetExtension(File) == TEXT("uasset"))
-        {
-            const FString Path = FPaths::GetPath(File);
-            UniquePaths.Add(Path);
-            UE_LOG(LogTemp, Display, TEXT("[Vault] Queued path to rescan: %s"), *Path);
-        }
+        ShowEditorNotification(TEXT("Import skipped: the project already has identical files."), true);
+        UE_LOG(LogAssetVault, Log, TEXT("Import complete: all %d file(s) are identical, nothing to import"), NumIdentical);
+        return true;
     }
 
-    FAssetRegistryModule& ARM = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-    for (const FString& Path : UniquePaths)
+    if (CopiedFiles.Num() == 0)
     {
-        UE_LOG(LogTemp, Display, TEXT("[Vault] Scanning: %s"), *Path);
-        ARM.Get().ScanPathsSynchronous({ Path });
+        ShowEditorNotification(TEXT("Import failed: No files copied."), false);
+        UE_LOG(LogAssetVault, Error, TEXT("Import failed: nothing copied from %s"), *SourceFolder);
+        return false;
     }
 
-    if (ImportedAssets.Num() > 0)
+    FAssetVaultImportLoader::ScanFiles(CopiedPackageFiles, bForceOverwrite);
+    UE_LOG(LogAssetVault, Log, TEXT("Import registry rescan: %d package file(s) in %.1f ms"), CopiedPackageFiles.Num(), EndPhase());
+
+    const int32 NumUnloaded = FAssetVaultImportLoader::UnloadResidentPackages(ImportedPackages);
+    UE_LOG(LogAssetVault, Log, TEXT("Import unload: %d replaced package(s) in %.1f ms"), NumUnloaded, EndPhase());
+
+    if (GetDefault<UAssetVaultSettings>()->bLoadAssetsAfterImport)
+    {
+        FAssetVaultImportLoader::SortByDependencies(ImportedPackages);
+        FAssetVaultImportLoader::LoadAsync(ImportedPackages, [](const TArray<UObject*>& LoadedAssets)
+        {
+            if (LoadedAssets.Num() > 0)
+            {
+                FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
+                ContentBrowserModule.Get().SyncBrowserToAssets(LoadedAssets);
+            }
+        });
+        UE_LOG(LogAssetVault, Log, TEXT("Import load: queued %d package(s) for async loading in %.1f ms"), ImportedPackages.Num(), EndPhase());
+    }
+    else
     {
-        FContentBrowserModule& ContentBrowserModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
-        ContentBrowserModule.Get().SyncBrowserToAssets(ImportedAssets);
+        FAssetVaultImportLoader::SyncContentBrowser(ImportedPackages);
     }
 
     const FString DisplaySubfolder = TargetSubfolder.IsEmpty()
@@ -649,20 +1022,13 @@ bool UAssetPackageManager::ImportAssetFolderToProject(const FString& DefaultDire
 
     ShowEditorNotification(NotifyMessage, true);
 
-    UE_LOG(LogTemp, Log, TEXT("[Vault] Successfully imported %d file(s) to %s"), CopiedFiles.Num(), *TargetFolder);
-    UE_LOG(LogTemp, Warning, TEXT("----------------------------------------"));
-    UE_LOG(LogTemp, Warning, TEXT("VAULT IMPORT COMPLETE"));
-    UE_LOG(LogTemp, Warning, TEXT("----------------------------------------"));
-
-    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    UE_LOG(LogAssetVault, Log, TEXT("Import complete: %d file(s) to %s"), CopiedFiles.Num(), *TargetFolder);
     return true;
 }
 
-bool UAssetPackageManager::DoesAssetAlreadyExist(const FString& DefaultDirectory,const FString& RelativeExportPath,const FString& TargetSubfolder,TArray<FString>& OutConflictingAssets)
+FAssetVaultImportAnalysis UAssetPackageManager::AnalyzeImportConflicts(const FString& DefaultDirectory, const FString& RelativeExportPath, const FString& TargetSubfolder)
 {
-    UE_LOG(LogTemp, Warning, TEXT("\n----------------------------------------"));
-    UE_LOG(LogTemp, Warning, TEXT("VAULT CONFLICT CHECK BEGIN"));
-    UE_LOG(LogTemp, Warning, TEXT("----------------------------------------"));
+    FAssetVaultImportAnalysis Analysis;
 
     const FString SourceFolder = FPaths::Combine(DefaultDirectory, RelativeExportPath);
     const FString ContentDir = FPaths::ProjectContentDir();
@@ -670,55 +1036,56 @@ bool UAssetPackageManager::DoesAssetAlreadyExist(const FString& DefaultDirectory
         ? ContentDir
         : FPaths::ConvertRelativePathToFull(FPaths::Combine(ContentDir, TargetSubfolder));
 
-    UE_LOG(LogTemp, Display, TEXT("[Vault] SourceFolder: %s"), *SourceFolder);
-    UE_LOG(LogTemp, Display, TEXT("[Vault] TargetFolder: %s"), *TargetFolder);
-
-    OutConflictingAssets.Empty();
-
-    if (!FPaths::DirectoryExists(SourceFolder) || !FPaths::DirectoryExists(TargetFolder))
+    if (!FPaths::DirectoryExists(SourceFolder))
     {
-        UE_LOG(LogTemp, Error, TEXT("[Vault] One of the directories does not exist."));
-        return false;
+        UE_LOG(LogAssetVault, Error, TEXT("Import source folder does not exist: %s"), *SourceFolder);
+        return Analysis;
     }
 
-    UE_LOG(LogTemp, Warning, TEXT("[Vault] Scanning for conflicting assets..."));
-    IFileManager& FileManager = IFileManager::Get();
-    TArray<FString> FoundSources;
-    FileManager.FindFilesRecursive(FoundSources, *SourceFolder, TEXT("*.uasset"), true, false);
-
-    for (const FString& SourceFile : FoundSources)
+    const FAssetVaultExportSource ExportSource(SourceFolder);
+    if (!ExportSource.IsValid())
     {
-        FString SourcePrefix = SourceFolder;
-        FPaths::NormalizeFilename(SourcePrefix);
-        FPaths::CollapseRelativeDirectories(SourcePrefix);
+        UE_LOG(LogAssetVault, Error, TEXT("Import analysis failed: archive is corrupt: %s"), *FAssetVaultArchive::GetPath(SourceFolder));
+        return Analysis;
+    }
 
-        FString FullSource = SourceFile;
-        FPaths::NormalizeFilename(FullSource);
-        FPaths::CollapseRelativeDirectories(FullSource);
+    TArray<FAssetVaultExportFile> FoundFiles;
+    ExportSource.Gather(FAssetVaultCopyEngine::GetPackageExtensions(), FoundFiles);
 
-        if (!FullSource.StartsWith(SourcePrefix))
+    TArray<EAssetVaultImportFileState> FileStates;
+    ClassifyImportFiles(FoundFiles, TargetFolder, FileStates);
+
+    for (int32 Index = 0; Index < FoundFiles.Num(); ++Index)
+    {
+        switch (FileStates[Index])
         {
-            continue;
+        case EAssetVaultImportFileState::New:       Analysis.NewFiles.Add(FoundFiles[Index].RelativePath); break;
+        case EAssetVaultImportFileState::Identical: Analysis.IdenticalFiles.Add(FoundFiles[Index].RelativePath); break;
+        default:                                    Analysis.ModifiedFiles.Add(FoundFiles[Index].RelativePath); break;
         }
+    }
 
-        FString RelativePath = FullSource.RightChop(SourcePrefix.Len() + 1);
-        const FString TargetPath = FPaths::Combine(TargetFolder, RelativePath);
+    UE_LOG(LogAssetVault, Verbose, TEXT("Import analysis: %d new, %d identical, %d modified"),
+        Analysis.NewFiles.Num(), Analysis.IdenticalFiles.Num(), Analysis.ModifiedFiles.Num());
+    return Analysis;
+}
+
+bool UAssetPackageManager::DoesAssetAlreadyExist(const FString& DefaultDirectory,const FString& RelativeExportPath,const FString& TargetSubfolder,TArray<FString>& OutConflictingAssets)
+{
+    OutConflictingAssets.Empty();
 
-        if (FPaths::FileExists(TargetPath))
+    // Only modified packages are conflicts: new ones are imported as is and identical ones are skipped.
+    const FAssetVaultImportAnalysis Analysis = AnalyzeImportConflicts(DefaultDirectory, RelativeExportPath, TargetSubfolder);
+    for (const FString& ModifiedFile : Analysis.ModifiedFiles)
+    {
+        if (ModifiedFile.EndsWith(TEXT(".uasset")) || ModifiedFile.EndsWith(TEXT(".umap")))
         {
-            FString ConflictedName = FPaths::GetCleanFilename(TargetPath);
-            OutConflictingAssets.Add(ConflictedName);
-            UE_LOG(LogTemp, Warning, TEXT("[Vault] Conflict found: %s"), *ConflictedName);
+            OutConflictingAssets.Add(FPaths::GetCleanFilename(ModifiedFile));
         }
     }
 
-    bool bHasConflicts = OutConflictingAssets.Num() > 0;
-    UE_LOG(LogTemp, Warning, TEXT("[Vault] Conflict check result: %s"), bHasConflicts ? TEXT("YES") : TEXT("NO"));
-    UE_LOG(LogTemp, Warning, TEXT("----------------------------------------"));
-    UE_LOG(LogTemp, Warning, TEXT("VAULT CONFLICT CHECK END"));
-    UE_LOG(LogTemp, Warning, TEXT("----------------------------------------\n"));
-
-    return bHasConflicts;
+    UE_LOG(LogAssetVault, Log, TEXT("Conflict check: %d conflicting package(s) in %s"), OutConflictingAssets.Num(), *RelativeExportPath);
+    return OutConflictingAssets.Num() > 0;
 }
 
 bool UAssetPackageManager::DoesExportPathAlreadyContainAssets(const FString& ExportDirectory, const FAssetExportOptions& Options, FString& OutResolvedPath)
@@ -749,39 +1116,21 @@ bool UAssetPackageManager::DoesExportPathAlreadyContainAssets(const FString& Exp
 		true, false
 	);
 
-	const bool bExists = FoundAssets.Num() > 0;
-	UE_LOG(LogTemp, Warning, TEXT("[Vault] Export path conflict check: %s => %s"), bExists ? TEXT("YES") : TEXT("NO"), *TargetFolder);
+	const bool bExists = FoundAssets.Num() > 0 || FAssetVaultFileManifest::Exists(TargetFolder) || FAssetVaultArchive::Exists(TargetFolder);
+	UE_LOG(LogAssetVault, Verbose, TEXT("Export path conflict check: %s => %s"), bExists ? TEXT("YES") : TEXT("NO"), *TargetFolder);
 	return bExists;
 }
 
 void UAssetPackageManager::ShowEditorNotification(const FString& Message, bool bSuccess)
 {
-	
-	FString Clean = Message;
-	Clean.ReplaceInline(TEXT("\r"), TEXT(""));
-	Clean.ReplaceInline(TEXT("\n"), TEXT(" "));
-	Clean.ReplaceInline(TEXT("\t"), TEXT(" "));
-	if (Clean.IsEmpty())
+	// Commandlets run without Slate.
+	if (!FSlateApplication::IsInitialized())
 	{
-		Clean = bSuccess
-			? TEXT("Операция успешно завершена.")
-			: TEXT("Произошла ошибка.");
+		UE_LOG(LogAssetVault, Log, TEXT("%s"), *Message);
+		return;
 	}
-	
-	const FText TitleText = FText::FromString(Clean);
-	const FText SubText   = FText::FromString(TEXT("Asset Vault Plugin"));
-	
-	FNotificationInfo Info(TitleText);
-	Info.SubText              = SubText;
-	Info.bFireAndForget       = true;
-	Info.FadeInDuration       = 0.3f;
-	Info.ExpireDuration       = 4.0f;
-	Info.FadeOutDuration      = 1.5f;
-	Info.bUseThrobber         = false;
-	Info.bUseSuccessFailIcons = false;  
-	Info.Image = bSuccess?
-		 FAppStyle::GetBrush("Icons.Success"):
-		 FAppStyle::GetBrush("Icons.ErrorWithColor");
+
+	const FNotificationInfo Info = MakeVaultNotificationInfo(Message, bSuccess);
 	
 	TSharedPtr<SNotificationItem> Item = FSlateNotificationManager::Get().AddNotification(Info);
 	
@@ -793,119 +1142,66 @@ void UAssetPackageManager::ShowEditorNotification(const FString& Message, bool b
 	}
 }
 
-bool UAssetPackageManager::ExportMultipleAssetsToPackage(const TArray<UObject*>& Assets,const FString& ExportDirectory,const FAssetExportOptions& ExportOptions)
+TSharedPtr<SNotificationItem> UAssetPackageManager::ShowEditorProgressNotification(const FString& Message, FSimpleDelegate OnCancel)
 {
-	if (Assets.Num() == 0)
+	if (!FSlateApplication::IsInitialized())
 	{
-		UE_LOG(LogTemp, Error, TEXT("Export failed: no assets provided."));
-		return false;
+		return nullptr;
 	}
 
-	
-	FString TargetFolder = ExportDirectory;
-	FString AssetTypeStr = UEnum::GetValueAsString(ExportOptions.MainInfo.AssetType).Replace(TEXT("EAssetType::"), TEXT(""));
-	TargetFolder = FPaths::Combine(TargetFolder, AssetTypeStr);
+	FNotificationInfo Info = MakeVaultNotificationInfo(Message, true);
+	Info.bFireAndForget = false;
+	Info.bUseThrobber = true;
+	Info.Image = nullptr;
+	Info.ButtonDetails.Add(FNotificationButtonInfo(FText::FromString(TEXT("Cancel")), FText::GetEmpty(), OnCancel, SNotificationItem::CS_Pending));
 
-	if (!ExportOptions.MainInfo.CustomFolder.IsEmpty())
+	TSharedPtr<SNotificationItem> Item = FSlateNotificationManager::Get().AddNotification(Info);
+	if (Item.IsValid())
 	{
-		TargetFolder = FPaths::Combine(TargetFolder, ExportOptions.MainInfo.CustomFolder);
+		Item->SetCompletionState(SNotificationItem::CS_Pending);
 	}
+	return Item;
+}
 
-	TargetFolder = FPaths::Combine(TargetFolder, ExportOptions.MainInfo.Name);
-
-	if (!ExportOptions.MainInfo.Version.IsEmpty())
+void UAssetPackageManager::CompleteEditorNotification(const TSharedPtr<SNotificationItem>& Item, const FString& Message, bool bSuccess)
+{
+	if (!Item.IsValid())
 	{
-		TargetFolder = FPaths::Combine(TargetFolder, ExportOptions.MainInfo.Version);
+		ShowEditorNotification(Message, bSuccess);
+		return;
 	}
 
-	
-	if (!FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*TargetFolder))
+	Item->SetText(MakeVaultNotificationInfo(Message, bSuccess).Text);
+	Item->SetCompletionState(bSuccess ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+	Item->ExpireAndFadeout();
+}
+
+bool UAssetPackageManager::ExportMultipleAssetsToPackage(const TArray<UObject*>& Assets,const FString& ExportDirectory,const FAssetExportOptions& ExportOptions)
+{
+	if (Assets.Num() == 0)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to create directory: %s"), *TargetFolder);
+		UE_LOG(LogAssetVault, Error, TEXT("Export failed: no assets provided."));
 		return false;
 	}
 
-	
+	TArray<FName> RootPackages;
 	for (UObject* Asset : Assets)
 	{
-		if (!Asset) continue;
-
-		if (!CopyAssetWithDependencies(Asset, TargetFolder))
+		if (Asset)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("Failed to export asset and dependencies: %s"), *Asset->GetName());
+			RootPackages.AddUnique(Asset->GetOutermost()->GetFName());
 		}
 	}
-	
-	FString EngineVersion = ExportOptions.MainInfo.EngineVersion;
-	if (EngineVersion.IsEmpty())
-	{
-		FEngineVersion Ver = FEngineVersion::Current();
-		EngineVersion = FString::Printf(TEXT("%d.%d"), Ver.GetMajor(), Ver.GetMinor());
-	}
-	
-	TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
-	JsonObject->SetStringField(TEXT("Name"), ExportOptions.MainInfo.Name);
-	JsonObject->SetStringField(TEXT("AssetType"), UEnum::GetValueAsString(ExportOptions.MainInfo.AssetType));
-	JsonObject->SetStringField(TEXT("Description"), ExportOptions.MainInfo.Description);
-	JsonObject->SetStringField(TEXT("EngineVersion"), EngineVersion);
-	JsonObject->SetStringField(TEXT("Version"), ExportOptions.MainInfo.Version);
-	JsonObject->SetStringField(TEXT("VersionComment"), ExportOptions.MainInfo.VersionComment);
-	JsonObject->SetStringField(TEXT("CustomFolder"), ExportOptions.MainInfo.CustomFolder);
-	
-	FString RelativePath = TargetFolder;
-	FPaths::MakePathRelativeTo(RelativePath, *ExportDirectory);
-	const FString RootPrefix = TEXT("ResourceAssets/");
-	if (RelativePath.StartsWith(RootPrefix))
-	{
-		RelativePath = RelativePath.RightChop(RootPrefix.Len());
-	}
-	JsonObject->SetStringField(TEXT("RelativeExportPath"), RelativePath);
-	
-	TArray<TSharedPtr<FJsonValue>> TagsJson;
-	for (const FString& Tag : ExportOptions.AdditionalInfo.Tags)
-	{
-		TagsJson.Add(MakeShared<FJsonValueString>(Tag));
-	}
-	JsonObject->SetArrayField(TEXT("Tags"), TagsJson);
-	
-	TArray<FString> FoundUAssetFiles;
-	IFileManager::Get().FindFilesRecursive(
-		FoundUAssetFiles,
-		*TargetFolder,
-		TEXT("*.uasset"),
-		true, false
-	);
 
-	TArray<TSharedPtr<FJsonValue>> AssetNamesJson;
-	for (const FString& FilePath : FoundUAssetFiles)
+	FString Message;
+	if (!ExportPackagesToFolder(RootPackages, ExportDirectory, ExportOptions, ExportOptions.MainInfo.Name, Message))
 	{
-		const FString FileName = FPaths::GetBaseFilename(FilePath);
-		AssetNamesJson.Add(MakeShared<FJsonValueString>(FileName));
-	}
-
-	JsonObject->SetArrayField(TEXT("Assets"), AssetNamesJson);
-	
-	FString OutputString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-	if (!FJsonSerializer::Serialize(JsonObject, Writer))
-	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to serialize metadata to JSON."));
-		return false;
-	}
-	
-	const FString HashBase = ExportOptions.MainInfo.Name + AssetTypeStr + FDateTime::Now().ToString();
-	const uint32 SymbolCode = FCrc::StrCrc32(*HashBase);
-	FString FileName = FString::Printf(TEXT("%s_%s_%X.json"), *ExportOptions.MainInfo.Name, *AssetTypeStr, SymbolCode);
-	FPaths::MakeValidFileName(FileName);
-	const FString MetadataPath = FPaths::Combine(TargetFolder, FileName);
-
-	if (!FFileHelper::SaveStringToFile(OutputString, *MetadataPath))
-	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to save metadata to: %s"), *MetadataPath);
+		if (!Message.IsEmpty())
+		{
+			ShowEditorNotification(Message, false);
+		}
 		return false;
 	}
-
-	UE_LOG(LogTemp, Log, TEXT("Assets and metadata successfully exported to: %s"), *TargetFolder);
 	return true;
 }
 
@@ -933,22 +1229,19 @@ EAssetType UAssetPackageManager::GetAssetTypeByIndex(int32 Index)
 
 bool UAssetPackageManager::DeleteAssetsAtPath(const FString& TargetFolder)
 {
+	ASSETVAULT_SCOPE(Delete);
+
 	if (TargetFolder.IsEmpty())
 	{
-		UE_LOG(LogTemp, Error, TEXT("[Vault] DeleteAssetsAtPath failed: TargetFolder is empty."));
+		UE_LOG(LogAssetVault, Error, TEXT("DeleteAssetsAtPath failed: TargetFolder is empty."));
 		return false;
 	}
 	
 	FString CleanPath = TargetFolder;
 	FPaths::NormalizeDirectoryName(CleanPath);
-	UE_LOG(LogTemp, Warning, TEXT("----------------------------------------"));
-	UE_LOG(LogTemp, Warning, TEXT("VAULT DELETE BEGIN"));
-	UE_LOG(LogTemp, Warning, TEXT("----------------------------------------"));
-	UE_LOG(LogTemp, Warning, TEXT("[Vault] TargetFolder (normalized): %s"), *CleanPath);
-
 	if (!FPaths::DirectoryExists(CleanPath))
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[Vault] Directory does not exist: %s"), *CleanPath);
+		UE_LOG(LogAssetVault, Verbose, TEXT("Delete: directory does not exist: %s"), *CleanPath);
 		return true;
 	}
 	
@@ -957,14 +1250,11 @@ bool UAssetPackageManager::DeleteAssetsAtPath(const FString& TargetFolder)
 
 	if (!bSuccess)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[Vault] Failed to delete directory: %s"), *CleanPath);
+		UE_LOG(LogAssetVault, Error, TEXT("Failed to delete directory: %s"), *CleanPath);
 		return false;
 	}
 
-	UE_LOG(LogTemp, Warning, TEXT("[Vault] Successfully deleted folder and its contents: %s"), *CleanPath);
-	UE_LOG(LogTemp, Warning, TEXT("----------------------------------------"));
-	UE_LOG(LogTemp, Warning, TEXT("VAULT DELETE COMPLETE"));
-	UE_LOG(LogTemp, Warning, TEXT("----------------------------------------"));
+	UE_LOG(LogAssetVault, Log, TEXT("Deleted %s"), *CleanPath);
 
 	return true;
 }
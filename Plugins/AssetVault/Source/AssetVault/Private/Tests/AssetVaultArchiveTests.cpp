@@ -0,0 +1,229 @@
+#include "AssetVaultArchive.h"
+#include "AssetVaultCopyEngine.h"
+#include "AssetVaultSettings.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AssetVaultArchiveTests
+{
+	struct FTestFile
+	{
+		FString RelativePath;
+		TArray<uint8> Data;
+	};
+
+	// A small file, a compressible one spanning several chunks and an incompressible one.
+	static TArray<FTestFile> MakeFiles()
+	{
+		FRandomStream Random(42);
+		TArray<FTestFile> Files;
+
+		FTestFile& Small = Files.Emplace_GetRef();
+		Small.RelativePath = TEXT("Props/SM_Small.uasset");
+		Small.Data.SetNumUninitialized(1000);
+		for (uint8& Byte : Small.Data)
+		{
+			Byte = static_cast<uint8>(Random.RandRange(0, 255));
+		}
+
+		FTestFile& Pattern = Files.Emplace_GetRef();
+		Pattern.RelativePath = TEXT("Props/SM_Pattern.uexp");
+		Pattern.Data.SetNumUninitialized(FAssetVaultArchive::ChunkSize * 2 + 12345);
+		for (int32 Index = 0; Index < Pattern.Data.Num(); ++Index)
+		{
+			Pattern.Data[Index] = static_cast<uint8>((Index / 64) % 7);
+		}
+
+		FTestFile& Noise = Files.Emplace_GetRef();
+		Noise.RelativePath = TEXT("T_Noise.ubulk");
+		Noise.Data.SetNumUninitialized(FAssetVaultArchive::ChunkSize + 7);
+		for (uint8& Byte : Noise.Data)
+		{
+			Byte = static_cast<uint8>(Random.RandRange(0, 255));
+		}
+
+		return Files;
+	}
+
+	static bool RunRoundTrip(FAutomationTestBase& Test, EAssetVaultCompressionCodec Codec)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		const FString Root = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AssetVaultArchive"), FGuid::NewGuid().ToString());
+		const FString SourceDir = Root / TEXT("Source");
+		const FString ExportFolder = Root / TEXT("Export");
+		const FString ExtractDir = Root / TEXT("Extract");
+		PlatformFile.CreateDirectoryTree(*SourceDir);
+		PlatformFile.CreateDirectoryTree(*ExportFolder);
+		PlatformFile.CreateDirectoryTree(*ExtractDir);
+
+		const TArray<FTestFile> Files = MakeFiles();
+		const FString MetadataJson = TEXT("{\"Name\":\"RoundTrip\"}");
+		int64 TotalSize = 0;
+
+		{
+			FAssetVaultArchiveWriter Writer(ExportFolder, Codec, 4);
+			Test.TestTrue(TEXT("Archive opens for writing"), Writer.Open());
+
+			for (int32 Index = 0; Index < Files.Num(); ++Index)
+			{
+				const FString SourceFile = SourceDir / FString::Printf(TEXT("File%d.bin"), Index);
+				FFileHelper::SaveArrayToFile(Files[Index].Data, *SourceFile);
+				TotalSize += Files[Index].Data.Num();
+
+				FString Hash;
+				const EAssetVaultCopyStatus Status = Writer.AddFile(SourceFile, ExportFolder / Files[Index].RelativePath, PlatformFile.GetStatData(*SourceFile), Hash);
+				Test.TestEqual(*FString::Printf(TEXT("%s is added"), *Files[Index].RelativePath), Status, EAssetVaultCopyStatus::Copied);
+				Test.TestFalse(TEXT("Entry hash is recorded"), Hash.IsEmpty());
+			}
+
+			Test.TestTrue(TEXT("Archive is finalized"), Writer.Finalize(MetadataJson));
+		}
+
+		Test.TestTrue(TEXT("Archive exists"), FAssetVaultArchive::Exists(ExportFolder));
+		if (Codec != EAssetVaultCompressionCodec::None)
+		{
+			Test.TestTrue(TEXT("Compressed archive is smaller than its files"), PlatformFile.FileSize(*FAssetVaultArchive::GetPath(ExportFolder)) < TotalSize);
+		}
+
+		{
+			FAssetVaultArchiveReader Reader;
+			if (!Test.TestTrue(TEXT("Archive opens for reading"), Reader.Open(FAssetVaultArchive::GetPath(ExportFolder))))
+			{
+				PlatformFile.DeleteDirectoryRecursively(*Root);
+				return false;
+			}
+
+			Test.TestEqual(TEXT("Metadata JSON survives"), Reader.GetMetadataJson(), MetadataJson);
+			Test.TestEqual(TEXT("Entry count"), Reader.GetEntries().Num(), Files.Num());
+			Test.TestEqual(TEXT("Unknown entries are not found"), Reader.FindEntry(TEXT("Missing.uasset")), static_cast<int32>(INDEX_NONE));
+
+			for (int32 Index = 0; Index < Files.Num(); ++Index)
+			{
+				const int32 EntryIndex = Reader.FindEntry(Files[Index].RelativePath);
+				if (!Test.TestNotEqual(*FString::Printf(TEXT("%s is found"), *Files[Index].RelativePath), EntryIndex, static_cast<int32>(INDEX_NONE)))
+				{
+					continue;
+				}
+				Test.TestEqual(TEXT("Entry size"), Reader.GetEntries()[EntryIndex].Size, static_cast<int64>(Files[Index].Data.Num()));
+
+				const FString TargetFile = ExtractDir / FString::Printf(TEXT("File%d.bin"), Index);
+				Test.TestTrue(TEXT("Entry is extracted"), Reader.ExtractEntry(EntryIndex, TargetFile));
+
+				TArray<uint8> Extracted;
+				FFileHelper::LoadFileToArray(Extracted, *TargetFile);
+				Test.TestTrue(*FString::Printf(TEXT("%s content survives"), *Files[Index].RelativePath), Extracted == Files[Index].Data);
+			}
+		}
+
+		PlatformFile.DeleteDirectoryRecursively(*Root);
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetVaultArchiveRawTest, "AssetVault.Archive.RoundTripRaw",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FAssetVaultArchiveRawTest::RunTest(const FString& Parameters)
+{
+	return AssetVaultArchiveTests::RunRoundTrip(*this, EAssetVaultCompressionCodec::None);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetVaultArchiveCompressedTest, "AssetVault.Archive.RoundTripCompressed",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FAssetVaultArchiveCompressedTest::RunTest(const FString& Parameters)
+{
+	return AssetVaultArchiveTests::RunRoundTrip(*this, EAssetVaultCompressionCodec::Mermaid)
+		&& AssetVaultArchiveTests::RunRoundTrip(*this, EAssetVaultCompressionCodec::LZ4);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetVaultArchiveCorruptEntryTest, "AssetVault.Archive.CorruptEntryKeepsTarget",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FAssetVaultArchiveCorruptEntryTest::RunTest(const FString& Parameters)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString Root = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AssetVaultArchive"), FGuid::NewGuid().ToString());
+	const FString SourceFile = Root / TEXT("Source.bin");
+	const FString ExportFolder = Root / TEXT("Export");
+	const FString TargetFile = Root / TEXT("Target") / TEXT("SM_Small.uasset");
+	PlatformFile.CreateDirectoryTree(*ExportFolder);
+
+	const AssetVaultArchiveTests::FTestFile File = AssetVaultArchiveTests::MakeFiles()[0];
+	FFileHelper::SaveArrayToFile(File.Data, *SourceFile);
+	{
+		FAssetVaultArchiveWriter Writer(ExportFolder, EAssetVaultCompressionCodec::None, 0);
+		FString Hash;
+		Writer.Open();
+		Writer.AddFile(SourceFile, ExportFolder / File.RelativePath, PlatformFile.GetStatData(*SourceFile), Hash);
+		TestTrue(TEXT("Archive is finalized"), Writer.Finalize(TEXT("{}")));
+	}
+
+	// Flips a byte of the only entry's data, which starts right after the 64 byte header.
+	const FString ArchivePath = FAssetVaultArchive::GetPath(ExportFolder);
+	TArray<uint8> ArchiveData;
+	FFileHelper::LoadFileToArray(ArchiveData, *ArchivePath);
+	ArchiveData[64 + 100] ^= 0xFF;
+	FFileHelper::SaveArrayToFile(ArchiveData, *ArchivePath);
+
+	FFileHelper::SaveStringToFile(TEXT("existing package"), *TargetFile);
+
+	AddExpectedError(TEXT("Hash mismatch"), EAutomationExpectedErrorFlags::Contains, 1);
+	AddExpectedError(TEXT("Failed to extract"), EAutomationExpectedErrorFlags::Contains, 1);
+
+	FAssetVaultArchiveReader Reader;
+	if (TestTrue(TEXT("Archive opens, the table of contents is intact"), Reader.Open(ArchivePath)))
+	{
+		TestFalse(TEXT("Corrupt entry is not extracted"), Reader.ExtractEntry(Reader.FindEntry(File.RelativePath), TargetFile));
+	}
+
+	FString TargetContent;
+	FFileHelper::LoadFileToString(TargetContent, *TargetFile);
+	TestEqual(TEXT("Existing target is kept"), TargetContent, FString(TEXT("existing package")));
+
+	TArray<FString> TargetDirFiles;
+	IFileManager::Get().FindFiles(TargetDirFiles, *(FPaths::GetPath(TargetFile) / TEXT("*")), true, false);
+	TestEqual(TEXT("No temporary file is left"), TargetDirFiles.Num(), 1);
+
+	PlatformFile.DeleteDirectoryRecursively(*Root);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetVaultArchiveEscapingEntryTest, "AssetVault.Archive.RejectsEscapingEntries",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FAssetVaultArchiveEscapingEntryTest::RunTest(const FString& Parameters)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString Root = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AssetVaultArchive"), FGuid::NewGuid().ToString());
+	const FString SourceFile = Root / TEXT("Source.bin");
+	const FString ExportFolder = Root / TEXT("Export");
+	PlatformFile.CreateDirectoryTree(*ExportFolder);
+	FFileHelper::SaveStringToFile(TEXT("package"), *SourceFile);
+
+	// The writer stores the target relative to the export folder, one outside it becomes "../Outside.uasset".
+	{
+		FAssetVaultArchiveWriter Writer(ExportFolder, EAssetVaultCompressionCodec::None, 0);
+		FString Hash;
+		Writer.Open();
+		Writer.AddFile(SourceFile, Root / TEXT("Outside.uasset"), PlatformFile.GetStatData(*SourceFile), Hash);
+		TestTrue(TEXT("Archive is finalized"), Writer.Finalize(TEXT("{}")));
+	}
+
+	AddExpectedError(TEXT("is not a relative path inside the export"), EAutomationExpectedErrorFlags::Contains, 1);
+	FAssetVaultArchiveReader Reader;
+	TestFalse(TEXT("Archive with an escaping entry is rejected"), Reader.Open(FAssetVaultArchive::GetPath(ExportFolder)));
+
+	PlatformFile.DeleteDirectoryRecursively(*Root);
+	return true;
+}
+
+#endif
@@ -0,0 +1,57 @@
+#include "AssetVaultFileManifest.h"
+#include "AssetVaultSettings.h"
+#include "FAssetPackageManager.h"
+
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Changes the storage settings of the running editor and restores them.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetVaultExportStorageSwitchTest, "AssetVault.Export.StorageModeSwitch",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FAssetVaultExportStorageSwitchTest::RunTest(const FString& Parameters)
+{
+	UAssetVaultSettings* Settings = GetMutableDefault<UAssetVaultSettings>();
+	const EAssetVaultStorageMode PreviousStorageMode = Settings->StorageMode;
+	const bool bPreviousIncrementalExport = Settings->bIncrementalExport;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString VaultDir = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AssetVaultExport"), FGuid::NewGuid().ToString()));
+
+	FAssetExportOptions Options;
+	Options.MainInfo.Name = TEXT("StorageSwitch");
+	Options.MainInfo.AssetType = EAssetType::StaticMesh;
+	Options.MainInfo.Version = TEXT("1.0");
+
+	const FString ExportFolder = UAssetPackageManager::BuildExportPath(VaultDir, Options.MainInfo);
+	FString RelativeExportPath = ExportFolder;
+	FPaths::MakePathRelativeTo(RelativeExportPath, *(VaultDir / TEXT("")));
+
+	// No roots: the exports only write their storage files, the package below stands in for copied ones.
+	FString Message;
+	Settings->StorageMode = EAssetVaultStorageMode::Deduplicated;
+	Settings->bIncrementalExport = false;
+	TestTrue(TEXT("Deduplicated export succeeds"), UAssetPackageManager::ExportPackagesToFolder({}, VaultDir, Options, Options.MainInfo.Name, Message));
+	TestTrue(TEXT("Deduplicated export writes a manifest"), FAssetVaultFileManifest::Exists(ExportFolder));
+
+	FFileHelper::SaveStringToFile(TEXT("loose package"), *(ExportFolder / TEXT("SM_Loose.uasset")));
+
+	Settings->StorageMode = EAssetVaultStorageMode::Loose;
+	TestTrue(TEXT("Loose export succeeds"), UAssetPackageManager::ExportPackagesToFolder({}, VaultDir, Options, Options.MainInfo.Name, Message));
+	TestFalse(TEXT("Loose export removes the blob-backed manifest"), FAssetVaultFileManifest::Exists(ExportFolder));
+
+	const FAssetVaultImportAnalysis Analysis = UAssetPackageManager::AnalyzeImportConflicts(VaultDir, RelativeExportPath, TEXT("AssetVaultTests_") + FGuid::NewGuid().ToString());
+	TestEqual(TEXT("Import reads the loose files"), Analysis.NewFiles, TArray<FString>{ TEXT("SM_Loose.uasset") });
+
+	Settings->StorageMode = PreviousStorageMode;
+	Settings->bIncrementalExport = bPreviousIncrementalExport;
+	PlatformFile.DeleteDirectoryRecursively(*VaultDir);
+	return true;
+}
+
+#endif
@@ -0,0 +1,68 @@
+#include "FAssetPackageManager.h"
+
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AssetVaultImportTests
+{
+	static void WriteFile(const FString& FilePath, const ANSICHAR* Content)
+	{
+		TArray<uint8> Data;
+		Data.Append(reinterpret_cast<const uint8*>(Content), FCStringAnsi::Strlen(Content));
+		FFileHelper::SaveArrayToFile(Data, *FilePath);
+	}
+
+	static TArray<FString> Sorted(TArray<FString> Paths)
+	{
+		Paths.Sort();
+		return Paths;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetVaultImportClassificationTest, "AssetVault.Import.Classification",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FAssetVaultImportClassificationTest::RunTest(const FString& Parameters)
+{
+	using namespace AssetVaultImportTests;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString VaultDir = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AssetVaultImport"), FGuid::NewGuid().ToString()));
+	const FString RelativeExportPath = TEXT("StaticMesh/Crates/1.0");
+	const FString SourceFolder = VaultDir / RelativeExportPath;
+
+	// Imports only write under the project content directory, so the target is a throwaway folder there.
+	const FString TargetSubfolder = TEXT("AssetVaultTests_") + FGuid::NewGuid().ToString();
+	const FString TargetFolder = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectContentDir(), TargetSubfolder));
+
+	WriteFile(SourceFolder / TEXT("A.uasset"), "new package");
+	WriteFile(SourceFolder / TEXT("B.uasset"), "identical package");
+	WriteFile(SourceFolder / TEXT("Props/C.uasset"), "same size, new bytes");
+	WriteFile(SourceFolder / TEXT("Props/D.uexp"), "grown package");
+	WriteFile(SourceFolder / TEXT("Notes.txt"), "not a package");
+
+	WriteFile(TargetFolder / TEXT("B.uasset"), "identical package");
+	WriteFile(TargetFolder / TEXT("Props/C.uasset"), "same size, old bytes");
+	WriteFile(TargetFolder / TEXT("Props/D.uexp"), "package");
+	WriteFile(TargetFolder / TEXT("Notes.txt"), "a different note");
+
+	const FAssetVaultImportAnalysis Analysis = UAssetPackageManager::AnalyzeImportConflicts(VaultDir, RelativeExportPath, TargetSubfolder);
+	TestEqual(TEXT("New files"), Sorted(Analysis.NewFiles), TArray<FString>{ TEXT("A.uasset") });
+	TestEqual(TEXT("Identical files"), Sorted(Analysis.IdenticalFiles), TArray<FString>{ TEXT("B.uasset") });
+	TestEqual(TEXT("Modified files"), Sorted(Analysis.ModifiedFiles), TArray<FString>{ TEXT("Props/C.uasset"), TEXT("Props/D.uexp") });
+
+	TArray<FString> ConflictingAssets;
+	TestTrue(TEXT("Modified packages are conflicts"), UAssetPackageManager::DoesAssetAlreadyExist(VaultDir, RelativeExportPath, TargetSubfolder, ConflictingAssets));
+	TestEqual(TEXT("Only modified assets conflict"), ConflictingAssets, TArray<FString>{ TEXT("C.uasset") });
+
+	PlatformFile.DeleteDirectoryRecursively(*TargetFolder);
+	PlatformFile.DeleteDirectoryRecursively(*VaultDir);
+	return true;
+}
+
+#endif
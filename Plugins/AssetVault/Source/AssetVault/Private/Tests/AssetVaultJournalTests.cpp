@@ -0,0 +1,90 @@
+#include "AssetVaultJournal.h"
+
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AssetVaultJournalTests
+{
+	static TArray<TSharedPtr<FJsonValue>> DumpOperations(FAutomationTestBase& Test)
+	{
+		const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), FString::Printf(TEXT("AssetVaultJournal_%s.json"), *FGuid::NewGuid().ToString()));
+		Test.TestTrue(TEXT("Journal is dumped"), FAssetVaultJournal::Get().DumpToJson(FilePath));
+
+		FString Json;
+		FFileHelper::LoadFileToString(Json, *FilePath);
+		FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*FilePath);
+
+		TSharedPtr<FJsonObject> Root;
+		const TArray<TSharedPtr<FJsonValue>>* Operations = nullptr;
+		if (!Test.TestTrue(TEXT("Dump is valid JSON"), FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) && Root.IsValid())
+			|| !Test.TestTrue(TEXT("Dump lists operations"), Root->TryGetArrayField(TEXT("Operations"), Operations)))
+		{
+			return {};
+		}
+		return *Operations;
+	}
+}
+
+// Resets the journal of the running editor.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetVaultJournalRingTest, "AssetVault.Journal.RingBuffer",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FAssetVaultJournalRingTest::RunTest(const FString& Parameters)
+{
+	using namespace AssetVaultJournalTests;
+
+	FAssetVaultJournal& Journal = FAssetVaultJournal::Get();
+	Journal.Reset();
+
+	// Wraps the entry ring by a few entries, the oldest ones are overwritten.
+	constexpr int32 NumOverwritten = 5;
+	const uint32 OperationId = Journal.BeginOperation(TEXT("Test"), TEXT("Entries"));
+	for (int32 Index = 0; Index < FAssetVaultJournal::MaxEntries + NumOverwritten; ++Index)
+	{
+		Journal.Add(OperationId, EAssetVaultJournalAction::Copied, FString::FromInt(Index), 1, EAssetVaultCopyStrategy::Copy);
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Operations = DumpOperations(*this);
+	if (TestEqual(TEXT("One operation"), Operations.Num(), 1))
+	{
+		const TSharedPtr<FJsonObject>& Operation = Operations[0]->AsObject();
+		TestEqual(TEXT("Operation name"), Operation->GetStringField(TEXT("Name")), FString(TEXT("Test")));
+
+		const TArray<TSharedPtr<FJsonValue>>& Entries = Operation->GetArrayField(TEXT("Entries"));
+		if (TestEqual(TEXT("Entries are capped"), Entries.Num(), FAssetVaultJournal::MaxEntries))
+		{
+			TestEqual(TEXT("Oldest entries are dropped"), Entries[0]->AsObject()->GetStringField(TEXT("Path")), FString::FromInt(NumOverwritten));
+			TestEqual(TEXT("Newest entry is last"), Entries.Last()->AsObject()->GetStringField(TEXT("Path")), FString::FromInt(FAssetVaultJournal::MaxEntries + NumOverwritten - 1));
+			TestEqual(TEXT("Strategy is recorded"), Entries[0]->AsObject()->GetStringField(TEXT("Strategy")), FString(FAssetVaultFileCopy::GetStrategyName(EAssetVaultCopyStrategy::Copy)));
+		}
+	}
+
+	// Wraps the operation ring, entries of dropped operations are not dumped.
+	Journal.Reset();
+	for (int32 Index = 0; Index < FAssetVaultJournal::MaxOperations + NumOverwritten; ++Index)
+	{
+		const uint32 Id = Journal.BeginOperation(TEXT("Test"), FString::FromInt(Index));
+		Journal.Add(Id, EAssetVaultJournalAction::Failed, FString::FromInt(Index));
+	}
+
+	Operations = DumpOperations(*this);
+	if (TestEqual(TEXT("Operations are capped"), Operations.Num(), FAssetVaultJournal::MaxOperations))
+	{
+		TestEqual(TEXT("Oldest operations are dropped"), Operations[0]->AsObject()->GetStringField(TEXT("Context")), FString::FromInt(NumOverwritten));
+		TestEqual(TEXT("Newest operation is last"), Operations.Last()->AsObject()->GetStringField(TEXT("Context")), FString::FromInt(FAssetVaultJournal::MaxOperations + NumOverwritten - 1));
+
+		const TArray<TSharedPtr<FJsonValue>>& Entries = Operations[0]->AsObject()->GetArrayField(TEXT("Entries"));
+		TestTrue(TEXT("Entries stay with their operation"), Entries.Num() == 1 && Entries[0]->AsObject()->GetStringField(TEXT("Action")) == TEXT("Failed"));
+	}
+
+	Journal.Reset();
+	return true;
+}
+
+#endif
@@ -0,0 +1,133 @@
+#include "AssetVaultMetadata.h"
+
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AssetVaultMetadataTests
+{
+	static FAssetExportOptions MakeOptions()
+	{
+		FAssetExportOptions Options;
+		Options.MainInfo.Name = TEXT("Rusty Barrel");
+		Options.MainInfo.AssetType = EAssetType::StaticMesh;
+		Options.MainInfo.Description = TEXT("Oil drum, \"dented\"");
+		Options.MainInfo.EngineVersion = TEXT("5.5.0");
+		Options.MainInfo.Version = TEXT("2.1");
+		Options.MainInfo.VersionComment = TEXT("Fixed UVs");
+		Options.MainInfo.CustomFolder = TEXT("Props/Industrial");
+		Options.MainInfo.RelativeExportPath = TEXT("StaticMesh/Props/Industrial/Rusty Barrel/2.1");
+		Options.MainInfo.ExportedAssetNames = { TEXT("SM_Barrel"), TEXT("M_Barrel") };
+		Options.AdditionalInfo.Tags = { TEXT("Industrial"), TEXT("Prop") };
+		Options.AdditionalInfo.PreviewImagePaths = { TEXT("Previews/Barrel_0.png"), TEXT("Previews/Barrel_1.png") };
+		return Options;
+	}
+
+	// The same document the export writes.
+	static FString MakeJson(const FAssetExportOptions& Options)
+	{
+		auto MakeArray = [](const TArray<FString>& Values)
+		{
+			TArray<TSharedPtr<FJsonValue>> Array;
+			for (const FString& Value : Values)
+			{
+				Array.Add(MakeShared<FJsonValueString>(Value));
+			}
+			return Array;
+		};
+
+		TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+		Json->SetStringField(TEXT("Name"), Options.MainInfo.Name);
+		Json->SetStringField(TEXT("AssetType"), UEnum::GetValueAsString(Options.MainInfo.AssetType));
+		Json->SetStringField(TEXT("Description"), Options.MainInfo.Description);
+		Json->SetStringField(TEXT("EngineVersion"), Options.MainInfo.EngineVersion);
+		Json->SetStringField(TEXT("CustomFolder"), Options.MainInfo.CustomFolder);
+		Json->SetStringField(TEXT("RelativeExportPath"), Options.MainInfo.RelativeExportPath);
+		Json->SetStringField(TEXT("VersionComment"), Options.MainInfo.VersionComment);
+		Json->SetStringField(TEXT("Version"), Options.MainInfo.Version);
+		Json->SetArrayField(TEXT("Tags"), MakeArray(Options.AdditionalInfo.Tags));
+		Json->SetArrayField(TEXT("PreviewImages"), MakeArray(Options.AdditionalInfo.PreviewImagePaths));
+		Json->SetArrayField(TEXT("Assets"), MakeArray(Options.MainInfo.ExportedAssetNames));
+
+		FString Text;
+		FJsonSerializer::Serialize(Json, TJsonWriterFactory<>::Create(&Text));
+		return Text;
+	}
+
+	static void TestSameOptions(FAutomationTestBase& Test, const TCHAR* Source, const FAssetExportOptions& Actual, const FAssetExportOptions& Expected)
+	{
+		const FAssetMainInfo& A = Actual.MainInfo;
+		const FAssetMainInfo& E = Expected.MainInfo;
+		Test.TestEqual(*FString::Printf(TEXT("%s: Name"), Source), A.Name, E.Name);
+		Test.TestTrue(*FString::Printf(TEXT("%s: AssetType"), Source), A.AssetType == E.AssetType);
+		Test.TestEqual(*FString::Printf(TEXT("%s: Description"), Source), A.Description, E.Description);
+		Test.TestEqual(*FString::Printf(TEXT("%s: EngineVersion"), Source), A.EngineVersion, E.EngineVersion);
+		Test.TestEqual(*FString::Printf(TEXT("%s: Version"), Source), A.Version, E.Version);
+		Test.TestEqual(*FString::Printf(TEXT("%s: VersionComment"), Source), A.VersionComment, E.VersionComment);
+		Test.TestEqual(*FString::Printf(TEXT("%s: CustomFolder"), Source), A.CustomFolder, E.CustomFolder);
+		Test.TestEqual(*FString::Printf(TEXT("%s: RelativeExportPath"), Source), A.RelativeExportPath, E.RelativeExportPath);
+		Test.TestTrue(*FString::Printf(TEXT("%s: Assets"), Source), A.ExportedAssetNames == E.ExportedAssetNames);
+		Test.TestTrue(*FString::Printf(TEXT("%s: Tags"), Source), Actual.AdditionalInfo.Tags == Expected.AdditionalInfo.Tags);
+		Test.TestTrue(*FString::Printf(TEXT("%s: PreviewImages"), Source), Actual.AdditionalInfo.PreviewImagePaths == Expected.AdditionalInfo.PreviewImagePaths);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetVaultMetadataRoundTripTest, "AssetVault.Metadata.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FAssetVaultMetadataRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace AssetVaultMetadataTests;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString ExportFolder = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("AssetVaultMetadata"), FGuid::NewGuid().ToString());
+	PlatformFile.CreateDirectoryTree(*ExportFolder);
+
+	// A metadata file of an older export, which saving has to replace.
+	const FString StalePath = ExportFolder / TEXT("Rusty Barrel_StaticMesh_0123.json");
+	FFileHelper::SaveStringToFile(TEXT("{}"), *StalePath);
+
+	const FAssetExportOptions Options = MakeOptions();
+	const FString FileName = FAssetVaultMetadata::MakeFileName(Options.MainInfo.Name, Options.MainInfo.AssetType);
+	TestEqual(TEXT("File name"), FileName, FString(TEXT("Rusty Barrel_StaticMesh.json")));
+	TestTrue(TEXT("Metadata is saved"), FAssetVaultMetadata::SaveToExportFolder(ExportFolder, FileName, MakeJson(Options), Options));
+
+	const FString JsonPath = ExportFolder / FileName;
+	const FString BinaryPath = FAssetVaultMetadata::GetBinaryPath(JsonPath);
+	TestEqual(TEXT("Sidecar path"), FPaths::GetExtension(BinaryPath), FString(FAssetVaultMetadata::BinaryExtension));
+	TestFalse(TEXT("Older metadata files are removed"), PlatformFile.FileExists(*StalePath));
+
+	FAssetExportOptions FromJson;
+	if (TestTrue(TEXT("JSON loads"), FAssetVaultMetadata::LoadFromJsonFile(JsonPath, FromJson)))
+	{
+		TestSameOptions(*this, TEXT("JSON"), FromJson, Options);
+	}
+
+	FAssetExportOptions FromBinary;
+	if (TestTrue(TEXT("Sidecar loads"), FAssetVaultMetadata::LoadFromBinaryFile(BinaryPath, FromBinary)))
+	{
+		TestSameOptions(*this, TEXT("Sidecar"), FromBinary, Options);
+	}
+
+	FAssetExportOptions Parsed;
+	TestTrue(TEXT("Missing fields use their defaults"), FAssetVaultMetadata::ParseJson(TEXT("{\"Name\":\"Bare\"}"), Parsed));
+	TestEqual(TEXT("Default version"), Parsed.MainInfo.Version, FString(TEXT("1.0")));
+	TestFalse(TEXT("Malformed JSON fails"), FAssetVaultMetadata::ParseJson(TEXT("{\"Name\":"), Parsed));
+
+	// Sidecars that are not compact binary or were written by another schema are ignored, scans fall back to the JSON.
+	AddExpectedError(TEXT("Invalid metadata sidecar"), EAutomationExpectedErrorFlags::Contains, 1);
+	const FString CorruptPath = ExportFolder / TEXT("Corrupt.avmeta");
+	FFileHelper::SaveStringToFile(TEXT("not compact binary"), *CorruptPath);
+	TestFalse(TEXT("Corrupt sidecar fails"), FAssetVaultMetadata::LoadFromBinaryFile(CorruptPath, Parsed));
+	TestFalse(TEXT("Missing sidecar fails"), FAssetVaultMetadata::LoadFromBinaryFile(ExportFolder / TEXT("Missing.avmeta"), Parsed));
+
+	PlatformFile.DeleteDirectoryRecursively(*ExportFolder);
+	return true;
+}
+
+#endif
@@ -0,0 +1,77 @@
+#include "AssetVaultSearchIndex.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AssetVaultSearchIndexTests
+{
+	static void Add(FAssetVaultSearchIndex& Index, const TCHAR* Name, EAssetType AssetType, const TCHAR* Description, TArray<FString> Tags)
+	{
+		FAssetExportOptions Options;
+		Options.MainInfo.Name = Name;
+		Options.MainInfo.AssetType = AssetType;
+		Options.MainInfo.Description = Description;
+		Options.AdditionalInfo.Tags = MoveTemp(Tags);
+		Index.AddOrUpdate(FString(Name) + TEXT(".json"), Options);
+	}
+
+	static TArray<FString> Search(const FAssetVaultSearchIndex& Index, const TCHAR* Query, EAssetType FilterType = EAssetType::All)
+	{
+		TArray<FAssetVaultSearchHit> Hits;
+		Index.Search(Query, FilterType, 100, Hits);
+
+		TArray<FString> Names;
+		for (const FAssetVaultSearchHit& Hit : Hits)
+		{
+			Names.Add(Index.GetEntry(Hit.Handle).MainInfo.Name);
+		}
+		return Names;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetVaultSearchIndexTest, "AssetVault.SearchIndex.PrefixAndTypos",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FAssetVaultSearchIndexTest::RunTest(const FString& Parameters)
+{
+	using namespace AssetVaultSearchIndexTests;
+
+	FAssetVaultSearchIndex Index;
+	Add(Index, TEXT("Rusty Barrel"), EAssetType::StaticMesh, TEXT("Oil drum"), { TEXT("Industrial") });
+	Add(Index, TEXT("Oak Tree"), EAssetType::StaticMesh, TEXT("Large deciduous tree"), {});
+	Add(Index, TEXT("Barrier Wall"), EAssetType::Blueprint, TEXT(""), {});
+	Add(Index, TEXT("M_Rust"), EAssetType::Material, TEXT(""), {});
+	TestEqual(TEXT("Entries"), Index.Num(), 4);
+
+	TArray<FString> Tokens;
+	FAssetVaultSearchIndex::Tokenize(TEXT("SM_rockLarge02"), Tokens);
+	TestEqual(TEXT("Tokenize splits at separators, humps and digits"), Tokens, TArray<FString>{ TEXT("sm"), TEXT("rock"), TEXT("large"), TEXT("02") });
+
+	TArray<FString> Names = Search(Index, TEXT("barr"));
+	TestEqual(TEXT("Prefix matches every completion"), Names.Num(), 2);
+	TestTrue(TEXT("Prefix finds Rusty Barrel"), Names.Contains(TEXT("Rusty Barrel")));
+	TestTrue(TEXT("Prefix finds Barrier Wall"), Names.Contains(TEXT("Barrier Wall")));
+
+	TestEqual(TEXT("Type filter"), Search(Index, TEXT("barr"), EAssetType::Blueprint), TArray<FString>{ TEXT("Barrier Wall") });
+
+	Names = Search(Index, TEXT("rust"));
+	TestEqual(TEXT("Exact and prefix matches"), Names.Num(), 2);
+	TestTrue(TEXT("Exact match ranks above a completion"), Names.Num() == 2 && Names[0] == TEXT("M_Rust"));
+
+	TestEqual(TEXT("One typo in a short word"), Search(Index, TEXT("barel")), TArray<FString>{ TEXT("Rusty Barrel") });
+	TestEqual(TEXT("Two typos in a long word"), Search(Index, TEXT("indstrail")), TArray<FString>{ TEXT("Rusty Barrel") });
+	TestEqual(TEXT("Short words are not matched with typos"), Search(Index, TEXT("oek")).Num(), 0);
+
+	TestEqual(TEXT("Every word has to match"), Search(Index, TEXT("large tree")), TArray<FString>{ TEXT("Oak Tree") });
+	TestEqual(TEXT("Unrelated words match nothing"), Search(Index, TEXT("qqqqq")).Num(), 0);
+	TestEqual(TEXT("An empty query lists every entry"), Search(Index, TEXT("")).Num(), 4);
+
+	TestTrue(TEXT("Entries can be removed"), Index.Remove(TEXT("Rusty Barrel.json")));
+	TestEqual(TEXT("Removed entries are no longer found"), Search(Index, TEXT("barr")), TArray<FString>{ TEXT("Barrier Wall") });
+	TestEqual(TEXT("Typo matches drop removed entries"), Search(Index, TEXT("barel")).Num(), 0);
+
+	return true;
+}
+
+#endif
@@ -1,3 +1,5 @@
 ﻿#pragma once
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+
+ASSETVAULT_API DECLARE_LOG_CATEGORY_EXTERN(LogAssetVault, Log, All);
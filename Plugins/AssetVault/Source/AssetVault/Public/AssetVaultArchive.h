@@ -0,0 +1,124 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/UniquePtr.h"
+
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+struct FFileStatData;
+enum class EAssetVaultCompressionCodec : uint8;
+enum class EAssetVaultCopyStatus : uint8;
+
+namespace AssetVaultArchive
+{
+	struct FChunkWindow;
+}
+
+// A run of file data inside the archive. Stored raw when CompressedSize == Size.
+struct FAssetVaultArchiveChunk
+{
+	uint64 Offset = 0;
+	uint32 CompressedSize = 0;
+	uint32 Size = 0;
+};
+
+struct FAssetVaultArchiveEntry
+{
+	// Path relative to the export folder, e.g. "Props/SM_Rock.uasset".
+	FString RelativePath;
+	int64 Size = 0;
+	FDateTime SourceTimestamp;
+	FString Hash;
+	int32 FirstChunk = 0;
+	int32 NumChunks = 0;
+};
+
+// Single-file export format: a fixed header, file data as chunks, then a table of contents
+// holding the entries, the chunk table and the export metadata JSON.
+// Lives next to the metadata file as <ExportFolder>/AssetVault.avpak.
+struct ASSETVAULT_API FAssetVaultArchive
+{
+	static const TCHAR* FileName;
+
+	// Every chunk starts on a multiple of this.
+	static constexpr int64 Alignment = 16;
+	static constexpr uint32 ChunkSize = 256 * 1024;
+
+	static FString GetPath(const FString& ExportFolder);
+	static bool Exists(const FString& ExportFolder);
+};
+
+// Streams package files into a new archive. AddFile is thread safe, so the copy engine's
+// workers can feed it directly. The archive only replaces an existing one on Finalize.
+class ASSETVAULT_API FAssetVaultArchiveWriter
+{
+public:
+
+	// Chunks are compressed on the task workers with the given codec, EAssetVaultCompressionCodec::None stores them raw.
+	FAssetVaultArchiveWriter(const FString& InExportFolder, EAssetVaultCompressionCodec InCodec, int32 InCompressionLevel);
+	~FAssetVaultArchiveWriter();
+
+	bool Open();
+
+	// TargetFile is the logical location inside the export folder, used as the entry path.
+	// Large files are pipelined: the next window of chunks is read while the current one is compressed.
+	EAssetVaultCopyStatus AddFile(const FString& SourceFile, const FString& TargetFile, const FFileStatData& SourceStat, FString& OutHash);
+
+	// Writes the table of contents and moves the archive into place.
+	bool Finalize(const FString& MetadataJson);
+
+	const FString& GetArchivePath() const { return ArchivePath; }
+
+private:
+	void CompressWindow(AssetVaultArchive::FChunkWindow& Window) const;
+	bool AppendWindow(const AssetVaultArchive::FChunkWindow& Window, TArray<FAssetVaultArchiveChunk>& OutChunks);
+	void Abort();
+
+	FString ExportFolder;
+	FString ArchivePath;
+	FString TempPath;
+	EAssetVaultCompressionCodec Codec;
+	int32 CompressionLevel = 0;
+	FName CompressionFormat;
+
+	FCriticalSection Lock;
+	TUniquePtr<IFileHandle> Handle;
+	int64 WriteOffset = 0;
+	TArray<FAssetVaultArchiveEntry> Entries;
+	TArray<FAssetVaultArchiveChunk> Chunks;
+	bool bWriteFailed = false;
+};
+
+// Read access to an archive through a memory mapping of the whole file: one open, no temp folder,
+// raw chunks are written to their targets straight from the mapped pages.
+class ASSETVAULT_API FAssetVaultArchiveReader
+{
+public:
+
+	FAssetVaultArchiveReader();
+	~FAssetVaultArchiveReader();
+
+	bool Open(const FString& InArchivePath);
+
+	const TArray<FAssetVaultArchiveEntry>& GetEntries() const { return Entries; }
+	const FString& GetMetadataJson() const { return MetadataJson; }
+	int32 FindEntry(const FString& RelativePath) const;
+
+	// Safe to call from several threads at once. Compressed chunks are decoded in parallel.
+	bool ExtractEntry(int32 EntryIndex, const FString& TargetFile) const;
+
+private:
+	FString ArchivePath;
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	const uint8* Data = nullptr;
+	int64 DataSize = 0;
+
+	FName CompressionFormat;
+	TArray<FAssetVaultArchiveEntry> Entries;
+	TArray<FAssetVaultArchiveChunk> Chunks;
+	TMap<FString, int32> EntryIndices;
+	FString MetadataJson;
+};
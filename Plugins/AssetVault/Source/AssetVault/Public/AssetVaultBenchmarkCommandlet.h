@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AssetVaultBenchmarkCommandlet.generated.h"
+
+// Generates a synthetic project and vault, times the UAssetPackageManager entry points against them and writes
+// AssetVaultBenchmark.csv and AssetVaultBenchmark.json with throughput, latency percentiles and peak memory.
+//
+//   UnrealEditor-Cmd <Project> -run=AssetVaultBenchmark -nullrhi -unattended
+//       [-Packages=200] [-FanOut=3] [-MinSizeKB=4] [-MaxSizeKB=1024] [-Exports=20] [-VaultEntries=1000]
+//       [-Iterations=5] [-Seed=1] [-Output=<Dir>] [-KeepData]
+//
+// Packages are written to /Game/AssetVaultBenchmark, imports go to /Game/AssetVaultBenchmarkImport.
+// Both folders and the vault are deleted at the end unless -KeepData is given.
+UCLASS()
+class UAssetVaultBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UAssetVaultBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
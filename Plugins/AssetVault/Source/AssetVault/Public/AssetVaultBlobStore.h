@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EAssetVaultCopyStatus : uint8;
+enum class EAssetVaultCopyStrategy : uint8;
+
+// Content-addressed storage shared by all deduplicated exports of a vault.
+// Every package file is stored once under <VaultRoot>/.AssetVaultBlobs/<2 hex>/<hash>.
+class ASSETVAULT_API FAssetVaultBlobStore
+{
+public:
+
+	static const TCHAR* DirectoryName;
+
+	explicit FAssetVaultBlobStore(const FString& VaultRoot);
+
+	const FString& GetRoot() const { return Root; }
+
+	// Hashes the source file and writes it into the store unless a blob with that hash already exists.
+	// Returns Copied for new blobs, Unchanged when the blob was already present.
+	EAssetVaultCopyStatus Store(const FString& SourceFile, int64 FileSize, bool bAllowClone, FString& OutHash, EAssetVaultCopyStrategy& OutStrategy) const;
+
+	bool Contains(const FString& Hash, int64 FileSize) const;
+
+	static FString GetBlobPath(const FString& BlobRoot, const FString& Hash);
+
+private:
+	FString Root;
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetVaultTypes.h"
+
+#include <atomic>
+
+struct FAssetVaultCatalogEntry
+{
+	// Metadata file name inside its directory.
+	FString MetadataFile;
+	// Modification time of the metadata file, i.e. when the entry was exported or last edited.
+	FDateTime Timestamp;
+	FAssetExportOptions Options;
+};
+
+// Hooks for progressive consumers of FAssetVaultCatalog::Refresh. Callbacks run on the refreshing thread.
+struct FAssetVaultCatalogRefreshContext
+{
+	// Number of metadata files parsed (and reported) per step.
+	int32 BatchSize = 256;
+
+	// Parsing starts while the vault is still being walked. A smaller batch is parsed and reported when the walk
+	// has not found a full one within this time, so large vaults show their first entries early.
+	double MaxBatchDelaySeconds = 0.05;
+
+	TFunction<void(TArray<FAssetExportOptions>&&)> OnEntriesParsed;
+
+	// Checked for every listed directory and between batches. A cancelled refresh leaves the catalog incomplete,
+	// it must not be saved.
+	const std::atomic<bool>* CancelFlag = nullptr;
+
+	// When set, receives the entries that were added, re-parsed or removed by the refresh.
+	FAssetVaultChangeSet* Changes = nullptr;
+
+	bool IsCancelled() const { return CancelFlag && CancelFlag->load(); }
+};
+
+// Parsed metadata of a whole vault, persisted as a compact binary file at the vault root.
+// Refresh() only re-reads directories whose modification time changed since the last scan.
+class ASSETVAULT_API FAssetVaultCatalog
+{
+public:
+
+	static const TCHAR* FileName;
+
+	explicit FAssetVaultCatalog(const FString& InVaultRoot);
+
+	// Returns false (and leaves the catalog empty) when the file is missing, outdated or corrupt.
+	bool Load();
+	bool Save();
+
+	// Returns true when any directory was re-read, added or removed.
+	bool Refresh(const FAssetVaultCatalogRefreshContext* Context = nullptr);
+
+	// Same as Refresh, limited to the given directories (relative to the vault root) and everything below them.
+	bool RefreshSubtrees(const TArray<FString>& RelativeDirs, const FAssetVaultCatalogRefreshContext* Context = nullptr);
+
+	const FString& GetVaultRoot() const { return VaultRoot; }
+
+	void GetAllEntries(TArray<FAssetExportOptions>& OutEntries) const;
+
+	// Calls Visitor for every entry with its metadata file path relative to the vault root, in catalog order.
+	void ForEachEntry(TFunctionRef<void(const FString& MetadataPath, const FAssetVaultCatalogEntry& Entry)> Visitor) const;
+
+	const FAssetVaultCatalogEntry* FindEntry(const FString& MetadataPath) const;
+
+	// Calls Visitor with consecutive slices of at most BatchSize entries, in catalog order.
+	void ForEachBatch(int32 BatchSize, TFunctionRef<void(TArray<FAssetExportOptions>&&)> Visitor) const;
+
+	int32 NumEntries() const;
+
+private:
+	struct FDirectory
+	{
+		FDateTime Timestamp;
+		TArray<FAssetVaultCatalogEntry> Entries;
+	};
+
+	struct FScanResult;
+	struct FRefreshState;
+
+	// Called for each directory right after it was listed: queues its metadata files when its timestamp changed
+	// and parses the queue once a batch is due. Returns false when the refresh was cancelled.
+	bool QueueDirectory(FRefreshState& State, const FString& RelativeDir);
+	bool ParsePending(FRefreshState& State);
+
+	// Parses what is left, reports changes and drops directories the walk did not see. Scopes limit removals, empty = whole vault.
+	bool FinishRefresh(FRefreshState& State, const TArray<FString>& Scopes);
+
+	void Serialize(FArchive& Ar);
+
+	FString VaultRoot;
+
+	// Keyed by directory path relative to the vault root, kept sorted for a stable entry order.
+	TMap<FString, FDirectory> Directories;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AssetVaultCommandlet.generated.h"
+
+// Runs a batch of exports and imports without the editor UI and writes a JSON report of every job.
+//
+//   UnrealEditor-Cmd <Project> -run=AssetVault -Batch=<File.json> -nullrhi -unattended
+//       [-Vault=<Dir>] [-Report=<File.json>] [-Journal=<File.json>] [-StopOnError]
+//
+// Batch file:
+//   {
+//     "Vault": "<Dir>",
+//     "Exports": [ { "Assets": [ "/Game/Props/SM_Rock" ], "Paths": [ "/Game/Props/Trees" ], "Options": { FAssetExportOptions } } ],
+//     "Imports": [ { "Entry": "<RelativeExportPath>", "TargetSubfolder": "Vault", "Overwrite": false } ]
+//   }
+//
+// The asset registry is scanned once up front and the dependency cache is shared by all exports, so jobs after
+// the first only pay for their own files. Exports run before imports. Returns 1 if any job failed.
+UCLASS()
+class UAssetVaultCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UAssetVaultCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EAssetVaultCompressionCodec : uint8;
+
+// Chunk codecs of packed exports. Oodle compressors share one format name, the decoder tells them apart.
+struct ASSETVAULT_API FAssetVaultCompression
+{
+	// NAME_None for EAssetVaultCompressionCodec::None.
+	static FName GetFormatName(EAssetVaultCompressionCodec Codec);
+
+	// Returns false when the codec failed or the result is not smaller than the input.
+	static bool Compress(EAssetVaultCompressionCodec Codec, int32 Level, const uint8* Data, int64 Size, TArray<uint8>& OutCompressed);
+
+	static bool Decompress(FName FormatName, const uint8* Compressed, int64 CompressedSize, uint8* OutData, int64 Size);
+};
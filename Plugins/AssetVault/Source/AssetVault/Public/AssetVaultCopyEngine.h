@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetVaultFileCopy.h"
+
+#include <atomic>
+
+class FAssetVaultArchiveWriter;
+class FAssetVaultBlobStore;
+struct FAssetVaultFileEntry;
+struct FFileStatData;
+
+// A unit of copy work. Package jobs carry paths without extension and copy the whole
+// package file set (.uasset/.umap + .uexp/.ubulk/.uptnl), file jobs copy one file as is.
+struct FAssetVaultCopyJob
+{
+	FString SourcePath;
+	FString TargetPath;
+	bool bPackageFileSet = false;
+
+	static FAssetVaultCopyJob Package(const FString& SourceBase, const FString& TargetBase)
+	{
+		return { SourceBase, TargetBase, true };
+	}
+
+	static FAssetVaultCopyJob File(const FString& SourceFile, const FString& TargetFile)
+	{
+		return { SourceFile, TargetFile, false };
+	}
+};
+
+enum class EAssetVaultCopyStatus : uint8
+{
+	Copied,
+	Failed,
+	// The target already holds identical content, nothing was written.
+	Unchanged,
+	// The package has neither a .uasset nor a .umap on disk.
+	Missing
+};
+
+struct FAssetVaultCopyResult
+{
+	FString SourceFile;
+	FString TargetFile;
+	// Size of the source file, BytesCopied is only non-zero when something was written.
+	int64 FileSize = 0;
+	int64 BytesCopied = 0;
+	FDateTime SourceTimestamp;
+	// Only filled when the content was hashed (blob store writes, incremental exports).
+	FString ContentHash;
+	EAssetVaultCopyStatus Status = EAssetVaultCopyStatus::Failed;
+	// None unless a file was written (archive entries and hashed copies are always regular copies).
+	EAssetVaultCopyStrategy Strategy = EAssetVaultCopyStrategy::None;
+};
+
+struct FAssetVaultCopyReport
+{
+	// Per-file results, in job order.
+	TArray<FAssetVaultCopyResult> Results;
+
+	int64 TotalBytes = 0;
+	int32 NumCopied = 0;
+	int32 NumFailed = 0;
+	int32 NumMissing = 0;
+	int32 NumUnchanged = 0;
+	double Seconds = 0.0;
+	// Written files per EAssetVaultCopyStrategy.
+	int32 NumByStrategy[static_cast<int32>(EAssetVaultCopyStrategy::Hardlink) + 1] = {};
+
+	// Set when the run was cancelled, jobs that had not started have no results.
+	bool bCancelled = false;
+
+	bool HasFailures() const { return NumFailed > 0; }
+
+	void Append(const FAssetVaultCopyReport& Other);
+
+	// E.g. "12 cloned, 3 copied", for logs.
+	FString DescribeStrategies() const;
+};
+
+// Counters of running copies, updated by the workers. Setting bCancel stops every worker before its next job.
+struct FAssetVaultCopyProgress
+{
+	std::atomic<int32> NumJobs{ 0 };
+	std::atomic<int32> JobsDone{ 0 };
+	std::atomic<int64> BytesCopied{ 0 };
+	std::atomic<bool> bCancel{ false };
+};
+
+class ASSETVAULT_API FAssetVaultCopyEngine
+{
+public:
+
+	// InNumWorkers <= 0 uses UAssetVaultSettings::CopyWorkerCount.
+	explicit FAssetVaultCopyEngine(int32 InNumWorkers = 0);
+
+	// Creates every target directory once, then copies the jobs on up to NumWorkers threads.
+	FAssetVaultCopyReport Run(const TArray<FAssetVaultCopyJob>& Jobs) const;
+
+	int32 GetNumWorkers() const { return NumWorkers; }
+
+	// Routes package files into a content-addressed store instead of TargetPath.
+	// TargetPath then only names the logical location recorded in the export manifest.
+	void SetBlobStore(const FAssetVaultBlobStore* InBlobStore) { BlobStore = InBlobStore; }
+
+	// Streams package files into a single archive instead of TargetPath, TargetPath names the entry.
+	void SetArchiveWriter(FAssetVaultArchiveWriter* InArchiveWriter) { ArchiveWriter = InArchiveWriter; }
+
+	// Enables incremental copies. Files are hashed while they are copied, and a file whose
+	// source size/mtime or content hash matches its previous entry (keyed by target path) is skipped.
+	void SetPreviousFiles(const TMap<FString, FAssetVaultFileEntry>* InPreviousFiles) { PreviousFiles = InPreviousFiles; }
+
+	// Reports progress of every following Run and lets it be cancelled.
+	void SetProgress(FAssetVaultCopyProgress* InProgress) { Progress = InProgress; }
+
+	static const TArray<FString>& GetPackageExtensions();
+
+private:
+	void RunJob(const FAssetVaultCopyJob& Job, TArray<FAssetVaultCopyResult>& OutResults) const;
+	void CopyOne(const FString& SourceFile, const FString& TargetFile, const FFileStatData& SourceStat, FAssetVaultCopyResult& Result) const;
+	bool IsUpToDate(const FAssetVaultFileEntry& Previous, const FString& TargetFile, const FFileStatData& SourceStat, FAssetVaultCopyResult& Result) const;
+
+	int32 NumWorkers = 1;
+	const FAssetVaultBlobStore* BlobStore = nullptr;
+	FAssetVaultArchiveWriter* ArchiveWriter = nullptr;
+	const TMap<FString, FAssetVaultFileEntry>* PreviousFiles = nullptr;
+	FAssetVaultCopyProgress* Progress = nullptr;
+	bool bUseFileClones = true;
+};
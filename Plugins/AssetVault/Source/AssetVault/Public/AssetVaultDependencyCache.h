@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "UObject/TopLevelAssetPath.h"
+
+#include <atomic>
+
+struct FAssetData;
+struct FAssetVaultDependencyScope;
+
+// Direct package dependencies read from the asset registry, remembered for the editor session.
+// A package's entry is dropped when the registry reports the package added, updated, renamed or removed.
+// Closures over many roots share one visited set, so every package is looked up once. Thread safe.
+class ASSETVAULT_API FAssetVaultDependencyCache
+{
+public:
+
+	static FAssetVaultDependencyCache& Get();
+
+	// Adds the roots and every package reachable from them that the scope lets through. Packages out of
+	// scope are pruned before their own dependencies are read, so their subgraphs are never walked.
+	// Stops early once CancelFlag is set. PackagesResolved counts the packages visited by this call.
+	void CollectClosure(TConstArrayView<FName> RootPackages, const FAssetVaultDependencyScope& Scope, TSet<FName>& InOutPackages,
+		const std::atomic<bool>* CancelFlag = nullptr, std::atomic<int32>* PackagesResolved = nullptr);
+
+	// Hard package dependencies only.
+	void GetDependencies(FName PackageName, TArray<FName>& OutDependencies);
+
+	void Invalidate(FName PackageName);
+	void Reset();
+
+	// Hooks invalidation to the asset registry events, called on module startup and shutdown.
+	void BindToAssetRegistry();
+	void UnbindFromAssetRegistry();
+
+	int32 GetNumHits() const { return NumHits.load(); }
+	int32 GetNumMisses() const { return NumMisses.load(); }
+
+private:
+	struct FEntry
+	{
+		TArray<FName> Hard;
+		TArray<FName> Soft;
+		// Class of the package's main asset, filled on first use by a class filter.
+		FTopLevelAssetPath AssetClass;
+		bool bAssetClassKnown = false;
+	};
+
+	FEntry GetEntry(FName PackageName, bool bNeedAssetClass);
+
+	void HandleAssetChanged(const FAssetData& AssetData);
+	void HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+	FRWLock Lock;
+	TMap<FName, FEntry> Entries;
+
+	std::atomic<int32> NumHits{ 0 };
+	std::atomic<int32> NumMisses{ 0 };
+
+	FDelegateHandle AddedHandle;
+	FDelegateHandle UpdatedHandle;
+	FDelegateHandle UpdatedOnDiskHandle;
+	FDelegateHandle RemovedHandle;
+	FDelegateHandle RenamedHandle;
+};
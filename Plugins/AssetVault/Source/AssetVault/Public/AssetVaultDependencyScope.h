@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/TopLevelAssetPath.h"
+
+// Which dependencies an export follows. Checked while the closure is walked, so a package out of scope
+// is never looked up in the registry and nothing only it references is visited.
+struct ASSETVAULT_API FAssetVaultDependencyScope
+{
+	// Prefixes with a trailing slash, e.g. "/Game/". Empty = every mount point.
+	TArray<FString> IncludedMountPoints;
+	TArray<FString> ExcludedMountPoints;
+	// Wildcards matched against package names.
+	TArray<FString> ExcludedPaths;
+	// Already expanded with every derived class.
+	TSet<FTopLevelAssetPath> ExcludedClasses;
+	// 0 = no limit, 1 = direct dependencies only.
+	int32 MaxDepth = 0;
+	bool bFollowSoftReferences = false;
+
+	// Built from UAssetVaultSettings.
+	static FAssetVaultDependencyScope FromSettings();
+
+	// Mount point and path rules, no registry access. Script packages are never in scope, they have no files.
+	bool IsPackageInScope(FName PackageName) const;
+
+	bool HasClassFilter() const { return ExcludedClasses.Num() > 0; }
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetVaultTypes.h"
+
+class FAssetVaultSearchIndex;
+
+// A filtered, sorted range of search index handles. Holds no entry copies and stays valid
+// until the index or the view cache changes.
+struct FAssetVaultEntryView
+{
+	TConstArrayView<int32> Handles;
+	// Descending views walk the ascending order backwards.
+	bool bDescending = false;
+
+	int32 Num() const { return Handles.Num(); }
+
+	int32 operator[](int32 Position) const
+	{
+		return bDescending ? Handles[Handles.Num() - 1 - Position] : Handles[Position];
+	}
+
+	// Handles of one page in view order. Pages past the end are empty.
+	void GetPage(int32 PageIndex, int32 PageSize, TArray<int32>& OutHandles) const;
+};
+
+// Sort orders over every entry of a search index, one per sort key, rebuilt lazily after the
+// index changes. Each order is also kept grouped by asset type, so filtering by type is a
+// lookup of a contiguous range. Ties are broken by name, then by metadata path, so pages are stable.
+class ASSETVAULT_API FAssetVaultEntryViews
+{
+public:
+
+	FAssetVaultEntryView GetView(const FAssetVaultSearchIndex& Index, EAssetType FilterType, EAssetVaultSortKey SortKey, bool bDescending);
+
+	void Reset();
+
+	// Leading numeric components of a version string ("5.4.2-3123+++UE5" -> 5, 4, 2), 16 bits each, for ordering.
+	static uint64 PackVersion(const FString& Version);
+
+private:
+	struct FSortOrder
+	{
+		uint32 Revision = 0;
+		bool bBuilt = false;
+		TArray<int32> All;
+		// Same handles grouped by asset type. TypeStarts[Type] .. TypeStarts[Type + 1] is the range of one type.
+		TArray<int32> ByType;
+		TArray<int32> TypeStarts;
+	};
+
+	void UpdateNameOrder(const FAssetVaultSearchIndex& Index);
+	void Build(const FAssetVaultSearchIndex& Index, EAssetVaultSortKey SortKey, FSortOrder& Order) const;
+
+	FSortOrder Orders[static_cast<int32>(EAssetVaultSortKey::Date) + 1];
+
+	// Every handle in name order. Other orders stable sort a copy of it, which makes name the tie breaker.
+	TArray<int32> ByName;
+	uint32 NameOrderRevision = 0;
+	bool bNameOrderBuilt = false;
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// How a file ended up at its target.
+enum class EAssetVaultCopyStrategy : uint8
+{
+	None,
+	// Regular read/write copy through the platform file layer.
+	Copy,
+	// Copy-on-write clone sharing the source's extents (FICLONE on Btrfs/XFS).
+	Clone,
+	// In-kernel copy (copy_file_range), no data passes through user space.
+	CopyRange,
+	// The target is a second name of the source file.
+	Hardlink
+};
+
+struct ASSETVAULT_API FAssetVaultFileCopy
+{
+	// Replaces TargetFile with the content of SourceFile, trying the cheapest strategy first:
+	// hardlink (only when allowed), clone, in-kernel copy, then a regular copy. Clones and in-kernel
+	// copies are only attempted on Linux and fall back silently when the file system refuses them.
+	// The content is written next to TargetFile under a temporary name, an existing target is only replaced on success.
+	static bool Copy(const FString& SourceFile, const FString& TargetFile, bool bAllowClone, bool bAllowHardlink, EAssetVaultCopyStrategy& OutStrategy);
+
+	// A unique name next to TargetFile for writing its new content to.
+	static FString MakeTempPath(const FString& TargetFile);
+
+	// Renames TempFile over TargetFile. Deletes TempFile if that fails, TargetFile is left as it was.
+	static bool ReplaceFile(const FString& TempFile, const FString& TargetFile);
+
+	static const TCHAR* GetStrategyName(EAssetVaultCopyStrategy Strategy);
+};
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct ASSETVAULT_API FAssetVaultFileHash
+{
+	// Streams the file through BLAKE3 and returns the digest as a hex string.
+	static bool HashFile(const FString& FilePath, FString& OutHash);
+
+	// Copies the file and hashes it in the same read pass.
+	static bool CopyFileAndHash(const FString& SourceFile, const FString& TargetFile, FString& OutHash);
+};
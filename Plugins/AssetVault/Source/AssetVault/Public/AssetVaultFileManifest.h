@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetVaultCopyReport;
+
+struct FAssetVaultFileEntry
+{
+	// Path of the package file relative to the export folder, e.g. "Props/SM_Chair.uasset".
+	FString RelativePath;
+	int64 Size = 0;
+	// Modification time of the project file the entry was exported from.
+	FDateTime SourceTimestamp;
+	FString Hash;
+};
+
+// What changed between two exports into the same folder.
+struct FAssetVaultExportDelta
+{
+	int32 NumAdded = 0;
+	int32 NumUpdated = 0;
+	int32 NumUnchanged = 0;
+	TArray<FString> RemovedFiles;
+};
+
+// List of package files that make up one export. Stored next to the metadata JSON.
+class ASSETVAULT_API FAssetVaultFileManifest
+{
+public:
+
+	static const TCHAR* FileName;
+
+	// Blob store folder relative to the export folder. Empty when the files are stored loose.
+	FString BlobRoot;
+
+	TArray<FAssetVaultFileEntry> Files;
+
+	bool IsBlobBacked() const { return !BlobRoot.IsEmpty(); }
+
+	// Adds one entry per hashed result of the report. Results are keyed by target path relative to ExportFolder.
+	void AddCopyResults(const FString& ExportFolder, const FAssetVaultCopyReport& Report);
+
+	FAssetVaultExportDelta Diff(const FAssetVaultFileManifest& Previous) const;
+
+	// Entries keyed by their absolute target path, as expected by FAssetVaultCopyEngine::SetPreviousFiles.
+	TMap<FString, FAssetVaultFileEntry> MakeTargetPathMap(const FString& ExportFolder) const;
+
+	// Physical location of the entry's content.
+	FString GetSourcePath(const FString& ExportFolder, const FAssetVaultFileEntry& Entry) const;
+
+	bool Load(const FString& ExportFolder);
+	bool Save(const FString& ExportFolder) const;
+
+	static bool Exists(const FString& ExportFolder);
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Post-import work that runs once all files are on disk: one registry scan for every copied
+// package, then a single batch of async loads queued dependencies first.
+struct ASSETVAULT_API FAssetVaultImportLoader
+{
+	// Registers the package files with the asset registry in one call.
+	static void ScanFiles(const TArray<FString>& PackageFiles, bool bForceRescan);
+
+	// Orders package names so every package comes after the imported packages it hard depends on.
+	// Cycles are broken at the first package of the cycle met in input order.
+	static void SortByDependencies(TArray<FName>& PackageNames);
+
+	// Selects the packages' assets in the Content Browser from registry data, without loading them.
+	static void SyncContentBrowser(const TArray<FName>& PackageNames);
+
+	// Unloads the packages that are still in memory from before the import, so the next load reads
+	// the new files. Packages that are not resident are left alone. Returns the number unloaded.
+	static int32 UnloadResidentPackages(const TArray<FName>& PackageNames);
+
+	// Queues an async load per package, earlier packages at higher priority. OnLoaded runs on the
+	// game thread once every request has finished, with the assets of the packages that loaded.
+	static void LoadAsync(const TArray<FName>& PackageNames, TFunction<void(const TArray<UObject*>&)> OnLoaded);
+};
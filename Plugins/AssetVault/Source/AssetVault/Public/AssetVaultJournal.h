@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetVaultFileCopy.h"
+#include "HAL/CriticalSection.h"
+
+enum class EAssetVaultJournalAction : uint8
+{
+	Copied,
+	Replaced,
+	SkippedIdentical,
+	SkippedExisting,
+	Failed,
+	ClosedEditor
+};
+
+struct FAssetVaultJournalEntry
+{
+	double Time = 0.0;
+	uint32 OperationId = 0;
+	EAssetVaultJournalAction Action = EAssetVaultJournalAction::Copied;
+	EAssetVaultCopyStrategy Strategy = EAssetVaultCopyStrategy::None;
+	int64 Bytes = 0;
+	FString Path;
+};
+
+// Per-file record of the latest vault operations, kept in memory instead of the log. Appending takes a lock and
+// moves the path in, nothing is formatted until the journal is dumped ("AssetVault.DumpJournal [File]").
+// Holds the last MaxEntries entries, older ones are overwritten.
+class ASSETVAULT_API FAssetVaultJournal
+{
+public:
+
+	static constexpr int32 MaxEntries = 65536;
+	static constexpr int32 MaxOperations = 256;
+
+	static FAssetVaultJournal& Get();
+
+	// Entries added with the returned id are grouped under this operation in the dump.
+	uint32 BeginOperation(const TCHAR* Name, const FString& Context);
+
+	void Add(uint32 OperationId, EAssetVaultJournalAction Action, FString Path, int64 Bytes = 0, EAssetVaultCopyStrategy Strategy = EAssetVaultCopyStrategy::None);
+
+	bool DumpToJson(const FString& FilePath) const;
+	void Reset();
+
+	static const TCHAR* GetActionName(EAssetVaultJournalAction Action);
+
+private:
+	struct FOperation
+	{
+		uint32 Id = 0;
+		FString Name;
+		FString Context;
+		double StartTime = 0.0;
+	};
+
+	mutable FCriticalSection Lock;
+	// Ring buffers, oldest at the Next* index once full.
+	TArray<FAssetVaultJournalEntry> Entries;
+	int32 NextEntry = 0;
+	TArray<FOperation> Operations;
+	int32 NextOperation = 0;
+	uint32 NextOperationId = 1;
+};
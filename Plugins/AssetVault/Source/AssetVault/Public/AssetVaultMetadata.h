@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetVaultTypes.h"
+
+class FJsonValue;
+
+// Reading and writing of the per-export metadata file (<Name>_<Type>.json, one per export folder).
+// Older exports wrote <Name>_<Type>_<Id>.json on every export, these are folded into the history on the next export.
+// Each JSON file may have a compact binary sidecar with the same base name, which scans read instead.
+struct ASSETVAULT_API FAssetVaultMetadata
+{
+	static const TCHAR* BinaryExtension;
+
+	// Bump whenever a field is added, removed or changes meaning. Sidecars of another version are ignored.
+	static constexpr int32 SchemaVersion = 2;
+
+	static bool LoadFromJsonFile(const FString& FilePath, FAssetExportOptions& OutOptions);
+
+	static bool ParseJson(const FString& JsonText, FAssetExportOptions& OutOptions);
+
+	static FString GetBinaryPath(const FString& JsonFilePath);
+
+	static FString MakeFileName(const FString& BaseName, EAssetType AssetType);
+
+	// Previous exports recorded by the metadata files already in ExportFolder, newest first, at most MaxEntries.
+	static TArray<TSharedPtr<FJsonValue>> CollectHistory(const FString& ExportFolder, int32 MaxEntries);
+
+	// Replaces the metadata of ExportFolder with FileName. The JSON and its sidecar are written to temporary
+	// files and renamed into place, then every other metadata file of the folder is deleted.
+	static bool SaveToExportFolder(const FString& ExportFolder, const FString& FileName, const FString& JsonText, const FAssetExportOptions& Options);
+
+	// Writes the fields the JSON holds as a compact binary object.
+	static bool SaveToBinaryFile(const FString& FilePath, const FAssetExportOptions& Options);
+
+	// Reads the sidecar in place, without building a document. Fails on a schema version mismatch.
+	static bool LoadFromBinaryFile(const FString& FilePath, FAssetExportOptions& OutOptions);
+};
+
+EAssetType StringToAssetType(const FString& AssetTypeStr);
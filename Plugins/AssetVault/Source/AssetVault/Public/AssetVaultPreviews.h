@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/List.h"
+#include "UObject/GCObject.h"
+
+class UTexture2D;
+
+// Thumbnails of an export's root assets, in one file next to the metadata file as <ExportFolder>/AssetVault.avpreview.
+// Images are kept as the packages store them (PNG or JPEG), keyed by object path, since root packages in
+// different folders may hold assets of the same name. Files written before version 2 are keyed by asset name.
+struct ASSETVAULT_API FAssetVaultPreviewFile
+{
+	static const TCHAR* FileName;
+
+	static FString GetPath(const FString& ExportFolder);
+
+	// Reads the thumbnail table from each package header, no asset is loaded and nothing is rendered.
+	// OutObjectPaths receives the assets that got a preview. Writes no file when there are none.
+	static bool Write(const FString& ExportFolder, TConstArrayView<FName> PackageNames, TArray<FString>& OutObjectPaths);
+
+	static bool ReadImage(const FString& ExportFolder, const FString& ObjectPath, TArray<uint8>& OutImage);
+};
+
+// Decoded previews, bounded by the memory of their textures. The least recently used ones are released first.
+// Game thread only.
+class ASSETVAULT_API FAssetVaultPreviewCache : public FGCObject
+{
+public:
+
+	explicit FAssetVaultPreviewCache(int64 InBudgetBytes);
+
+	// Decodes the preview on first use. Returns null for assets without one, which is remembered as well.
+	UTexture2D* Get(const FString& ExportFolder, const FString& ObjectPath);
+
+	// Drops every preview of the export, e.g. after it was exported again.
+	void Invalidate(const FString& ExportFolder);
+	void Reset();
+
+	int64 GetUsedBytes() const { return UsedBytes; }
+
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FAssetVaultPreviewCache"); }
+
+private:
+	struct FEntry
+	{
+		TObjectPtr<UTexture2D> Texture;
+		int64 Bytes = 0;
+		TDoubleLinkedList<FString>::TDoubleLinkedListNode* Node = nullptr;
+	};
+
+	void Remove(const FString& Key);
+
+	int64 BudgetBytes = 0;
+	int64 UsedBytes = 0;
+	TMap<FString, FEntry> Entries;
+	// Most recently used at the head.
+	TDoubleLinkedList<FString> UsageOrder;
+};
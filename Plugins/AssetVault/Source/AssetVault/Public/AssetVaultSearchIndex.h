@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetVaultTypes.h"
+
+struct FAssetVaultSearchHit
+{
+	int32 Handle = INDEX_NONE;
+	float Score = 0.f;
+};
+
+// In-memory inverted index over the searchable text of vault entries (name, description, tags,
+// custom folder, exported asset names). Entries are keyed by their metadata file and can be
+// added, replaced and removed one at a time. Queries match whole words, word prefixes and,
+// for longer words, terms within a small edit distance. Not thread safe.
+class ASSETVAULT_API FAssetVaultSearchIndex
+{
+public:
+
+	// Adds the entry, or replaces the one already stored under Key. Returns its handle.
+	int32 AddOrUpdate(const FString& Key, const FAssetExportOptions& Options, const FDateTime& Timestamp = FDateTime());
+	bool Remove(const FString& Key);
+	void Reset();
+
+	// Every word of the query has to match. Hits are ordered by score, then by name.
+	// An empty query returns every entry of the type, ordered by name.
+	void Search(const FString& Query, EAssetType FilterType, int32 MaxResults, TArray<FAssetVaultSearchHit>& OutHits) const;
+
+	// Handles stay valid until their entry is removed, freed handles are reused.
+	bool IsValidHandle(int32 Handle) const { return Documents.IsValidIndex(Handle) && Documents[Handle].bValid; }
+	const FAssetExportOptions& GetEntry(int32 Handle) const { return Documents[Handle].Options; }
+	const FString& GetKey(int32 Handle) const { return Documents[Handle].Key; }
+	const FDateTime& GetTimestamp(int32 Handle) const { return Documents[Handle].Timestamp; }
+	int32 FindHandle(const FString& Key) const;
+
+	int32 Num() const { return HandlesByKey.Num(); }
+	int32 GetMaxHandle() const { return Documents.Num(); }
+
+	// Changes whenever an entry is added, replaced or removed.
+	uint32 GetRevision() const { return Revision; }
+
+	// Splits text into lowercase words at separators, camelCase humps and letter/digit boundaries.
+	static void Tokenize(const FString& Text, TArray<FString>& OutTokens);
+
+private:
+	struct FPosting
+	{
+		int32 Handle;
+		float Weight;
+	};
+
+	struct FTerm
+	{
+		FString Text;
+		TArray<FPosting> Postings;
+	};
+
+	struct FDocument
+	{
+		FString Key;
+		FAssetExportOptions Options;
+		FDateTime Timestamp;
+		TArray<int32> TermIds;
+		bool bValid = false;
+	};
+
+	void IndexDocument(int32 Handle);
+	void UnindexDocument(int32 Handle);
+	int32 FindOrAddTerm(const FString& Text);
+
+	// Term ids whose text matches Token, with the factor their postings are scaled by.
+	void MatchTerms(const FString& Token, TArray<TPair<int32, float>>& OutMatches) const;
+
+	TArray<FDocument> Documents;
+	TArray<int32> FreeHandles;
+	TMap<FString, int32> HandlesByKey;
+
+	TArray<FTerm> Terms;
+	TMap<FString, int32> TermIds;
+	// Term ids ordered by text, so prefixes and first letters map to contiguous ranges.
+	TArray<int32> SortedTermIds;
+
+	uint32 Revision = 0;
+};
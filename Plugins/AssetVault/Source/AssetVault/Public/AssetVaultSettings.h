@@ -0,0 +1,120 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "AssetVaultSettings.generated.h"
+
+UENUM()
+enum class EAssetVaultStorageMode : uint8
+{
+	// Every export holds a full copy of its package files.
+	Loose,
+	// Package files are stored once per vault, keyed by content hash. Exports only hold a file manifest.
+	Deduplicated,
+	// Every export is a single .avpak archive next to its metadata file.
+	Packed
+};
+
+UENUM()
+enum class EAssetVaultCompressionCodec : uint8
+{
+	None,
+	// Oodle compressors, from fastest to smallest.
+	Selkie,
+	Mermaid,
+	Kraken,
+	Leviathan,
+	Zlib,
+	LZ4		UMETA(DisplayName = "LZ4")
+};
+
+UCLASS(Config = EditorPerProjectUserSettings, meta = (DisplayName = "Asset Vault"))
+class ASSETVAULT_API UAssetVaultSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
+
+	// Number of parallel workers used to copy package files. 0 = pick from the number of CPU cores.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = "0", ClampMax = "64"))
+	int32 CopyWorkerCount = 0;
+
+	// Memory for decoded preview textures in the vault browser. The least recently shown ones are released first.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = "1", ClampMax = "1024"))
+	int32 PreviewCacheSizeMB = 64;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Storage")
+	EAssetVaultStorageMode StorageMode = EAssetVaultStorageMode::Loose;
+
+	// Re-exports into an existing folder only copy files whose size, mtime or content hash changed,
+	// and delete files that are no longer part of the dependency closure.
+	UPROPERTY(Config, EditAnywhere, Category = "Storage")
+	bool bIncrementalExport = true;
+
+	// Previous exports kept in the History array of an export's metadata file, newest first.
+	UPROPERTY(Config, EditAnywhere, Category = "Storage", meta = (ClampMin = "0", ClampMax = "100"))
+	int32 MaxMetadataHistory = 10;
+
+	// Try copy-on-write clones (FICLONE) and in-kernel copies (copy_file_range) before a regular copy.
+	// Linux only, file systems without support fall back to a regular copy per file.
+	UPROPERTY(Config, EditAnywhere, Category = "Storage")
+	bool bUseFileClones = true;
+
+	// Codec for the chunks of packed exports. Chunks that do not shrink are stored raw.
+	UPROPERTY(Config, EditAnywhere, Category = "Storage", meta = (EditCondition = "StorageMode == EAssetVaultStorageMode::Packed"))
+	EAssetVaultCompressionCodec CompressionCodec = EAssetVaultCompressionCodec::Mermaid;
+
+	// Oodle level, -4 (HyperFast4) to 9 (Optimal5). Zlib and LZ4 only tell fast (below 4) from small (above 5).
+	UPROPERTY(Config, EditAnywhere, Category = "Storage", meta = (ClampMin = "-4", ClampMax = "9", EditCondition = "StorageMode == EAssetVaultStorageMode::Packed"))
+	int32 CompressionLevel = 3;
+
+	// Load imported packages after an import. When off, the Content Browser is synced from asset registry data
+	// and nothing is loaded; packages already in memory that the import replaced are unloaded instead.
+	UPROPERTY(Config, EditAnywhere, Category = "Import")
+	bool bLoadAssetsAfterImport = false;
+
+	// Hard link blobs of deduplicated exports into the project instead of copying them. Blobs are read-only,
+	// so the linked project files are as well: saving over them fails instead of corrupting the shared blob.
+	UPROPERTY(Config, EditAnywhere, Category = "Import")
+	bool bHardlinkVaultBlobs = false;
+
+	// Mount points exports follow dependencies into, e.g. "/Game". Empty = every mount point not excluded below.
+	UPROPERTY(Config, EditAnywhere, Category = "Dependencies")
+	TArray<FString> IncludedMountPoints;
+
+	// Dependencies under these mount points are neither copied nor walked.
+	UPROPERTY(Config, EditAnywhere, Category = "Dependencies")
+	TArray<FString> ExcludedMountPoints = { TEXT("/Engine"), TEXT("/Script") };
+
+	// Package name wildcards to leave out together with everything only they reference, e.g. "/Game/Developers/*".
+	UPROPERTY(Config, EditAnywhere, Category = "Dependencies")
+	TArray<FString> ExcludedPaths;
+
+	// Dependencies whose main asset is of one of these classes or a subclass are left out.
+	UPROPERTY(Config, EditAnywhere, Category = "Dependencies", meta = (MetaClass = "/Script/CoreUObject.Object"))
+	TArray<FSoftClassPath> ExcludedClasses;
+
+	// Levels of dependencies to follow from the exported assets. 0 = no limit.
+	UPROPERTY(Config, EditAnywhere, Category = "Dependencies", meta = (ClampMin = "0"))
+	int32 MaxDependencyDepth = 0;
+
+	// Also follow soft references, e.g. soft object pointers and redirect targets.
+	UPROPERTY(Config, EditAnywhere, Category = "Dependencies")
+	bool bFollowSoftReferences = false;
+
+	// Keep parsed metadata in a binary catalog at the vault root, so a refresh only re-reads changed directories.
+	UPROPERTY(Config, EditAnywhere, Category = "Storage")
+	bool bUseVaultCatalog = true;
+
+	// Parse metadata files of changed directories on all cores instead of one at a time.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bParallelMetadataScan = true;
+
+	// How long the vault folder has to be quiet before watched changes are applied to the catalog.
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = "0.0", Units = "s"))
+	float WatchDebounceSeconds = 0.5f;
+
+	int32 GetEffectiveCopyWorkerCount() const;
+};
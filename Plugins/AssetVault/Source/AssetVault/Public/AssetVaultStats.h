@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+// "stat AssetVault" in the editor, and CPU scopes plus counters in Insights (-trace=cpu,counters).
+
+DECLARE_STATS_GROUP(TEXT("AssetVault"), STATGROUP_AssetVault, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Export"), STAT_AssetVault_Export, STATGROUP_AssetVault, ASSETVAULT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Resolve Closure"), STAT_AssetVault_ResolveClosure, STATGROUP_AssetVault, ASSETVAULT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Copy"), STAT_AssetVault_Copy, STATGROUP_AssetVault, ASSETVAULT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Write Metadata"), STAT_AssetVault_WriteMetadata, STATGROUP_AssetVault, ASSETVAULT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Scan"), STAT_AssetVault_Scan, STATGROUP_AssetVault, ASSETVAULT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parse Metadata"), STAT_AssetVault_Parse, STATGROUP_AssetVault, ASSETVAULT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Import"), STAT_AssetVault_Import, STATGROUP_AssetVault, ASSETVAULT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Conflict Check"), STAT_AssetVault_ConflictCheck, STATGROUP_AssetVault, ASSETVAULT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Registry Rescan"), STAT_AssetVault_RegistryScan, STATGROUP_AssetVault, ASSETVAULT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Unload"), STAT_AssetVault_Unload, STATGROUP_AssetVault, ASSETVAULT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Load"), STAT_AssetVault_Load, STATGROUP_AssetVault, ASSETVAULT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Delete"), STAT_AssetVault_Delete, STATGROUP_AssetVault, ASSETVAULT_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Packages Resolved"), STAT_AssetVault_PackagesResolved, STATGROUP_AssetVault, ASSETVAULT_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Files Copied"), STAT_AssetVault_FilesCopied, STATGROUP_AssetVault, ASSETVAULT_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Files Unchanged"), STAT_AssetVault_FilesUnchanged, STATGROUP_AssetVault, ASSETVAULT_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Files Hashed"), STAT_AssetVault_FilesHashed, STATGROUP_AssetVault, ASSETVAULT_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Metadata Files Parsed"), STAT_AssetVault_FilesParsed, STATGROUP_AssetVault, ASSETVAULT_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Dependency Cache Hits"), STAT_AssetVault_CacheHits, STATGROUP_AssetVault, ASSETVAULT_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Dependency Cache Misses"), STAT_AssetVault_CacheMisses, STATGROUP_AssetVault, ASSETVAULT_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Bytes Copied"), STAT_AssetVault_BytesCopied, STATGROUP_AssetVault, ASSETVAULT_API);
+
+TRACE_DECLARE_INT_COUNTER_EXTERN(AssetVault_PackagesResolved);
+TRACE_DECLARE_INT_COUNTER_EXTERN(AssetVault_FilesCopied);
+TRACE_DECLARE_INT_COUNTER_EXTERN(AssetVault_FilesUnchanged);
+TRACE_DECLARE_INT_COUNTER_EXTERN(AssetVault_FilesHashed);
+TRACE_DECLARE_INT_COUNTER_EXTERN(AssetVault_FilesParsed);
+TRACE_DECLARE_INT_COUNTER_EXTERN(AssetVault_CacheHits);
+TRACE_DECLARE_INT_COUNTER_EXTERN(AssetVault_CacheMisses);
+TRACE_DECLARE_MEMORY_COUNTER_EXTERN(AssetVault_BytesCopied);
+
+// Cycle counter and Insights CPU scope for one phase, e.g. ASSETVAULT_SCOPE(Copy).
+#define ASSETVAULT_SCOPE(Phase) \
+	SCOPE_CYCLE_COUNTER(STAT_AssetVault_##Phase); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(AssetVault_##Phase)
+
+#define ASSETVAULT_COUNT(Counter, Amount) \
+	INC_DWORD_STAT_BY(STAT_AssetVault_##Counter, Amount); \
+	TRACE_COUNTER_ADD(AssetVault_##Counter, Amount)
+
+#define ASSETVAULT_COUNT_BYTES(Counter, Amount) \
+	INC_MEMORY_STAT_BY(STAT_AssetVault_##Counter, Amount); \
+	TRACE_COUNTER_ADD(AssetVault_##Counter, Amount)
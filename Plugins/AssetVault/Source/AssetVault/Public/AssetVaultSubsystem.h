@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetVaultEntryViews.h"
+#include "AssetVaultPreviews.h"
+#include "AssetVaultSearchIndex.h"
+#include "AssetVaultTypes.h"
+#include "Containers/Ticker.h"
+#include "EditorSubsystem.h"
+
+#include "AssetVaultSubsystem.generated.h"
+
+class FAssetVaultCatalog;
+class UTexture2D;
+struct FFileChangeData;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnVaultEntriesChanged, const FAssetVaultChangeSet&, Changes);
+
+// Keeps the catalog of one vault up to date while it is open. Changes on disk are collected by a
+// directory watcher, debounced, and applied to the touched directories only.
+UCLASS()
+class ASSETVAULT_API UAssetVaultSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	// Loads and refreshes the catalog of the vault, then starts watching it. Replaces the open vault.
+	UFUNCTION(BlueprintCallable, Category = "AssetVault|Vault")
+	bool OpenVault(const FString& VaultRoot);
+
+	UFUNCTION(BlueprintCallable, Category = "AssetVault|Vault")
+	void CloseVault();
+
+	UFUNCTION(BlueprintPure, Category = "AssetVault|Vault")
+	bool IsVaultOpen() const { return Catalog.IsValid(); }
+
+	UFUNCTION(BlueprintPure, Category = "AssetVault|Vault")
+	FString GetVaultRoot() const;
+
+	UFUNCTION(BlueprintCallable, Category = "AssetVault|Vault")
+	TArray<FAssetExportOptions> GetAllEntries() const;
+
+	// Ranked search over name, description, tags, custom folder and exported asset names.
+	// Matches word prefixes and small typos. MaxResults <= 0 returns every hit.
+	UFUNCTION(BlueprintCallable, Category = "AssetVault|Vault")
+	TArray<FAssetExportOptions> SearchEntries(const FString& Query, EAssetType FilterType, int32 MaxResults = 200) const;
+
+	UFUNCTION(BlueprintCallable, Category = "AssetVault|Vault")
+	int32 GetEntryCount(EAssetType FilterType);
+
+	// One page of the filtered, sorted entry list. Only the entries of the page are copied.
+	UFUNCTION(BlueprintCallable, Category = "AssetVault|Vault")
+	TArray<FAssetExportOptions> GetEntryPage(EAssetType FilterType, EAssetVaultSortKey SortKey, bool bDescending, int32 PageIndex, int32 PageSize = 100);
+
+	// Handles into GetSearchIndex(), valid until the next change to the vault.
+	FAssetVaultEntryView GetEntryView(EAssetType FilterType, EAssetVaultSortKey SortKey, bool bDescending);
+
+	const FAssetVaultSearchIndex& GetSearchIndex() const { return SearchIndex; }
+
+	// Preview of one of the entry's assets, decoded on first use and kept in a bounded cache.
+	// AssetName is one of the entry's PreviewImagePaths (object paths), a plain asset name picks the first asset
+	// of that name and an empty one the entry's first preview. Returns null when there is none.
+	UFUNCTION(BlueprintCallable, Category = "AssetVault|Vault")
+	UTexture2D* GetPreviewTexture(const FAssetExportOptions& Entry, const FString& AssetName);
+
+	// Broadcast with the entries that were added, edited or removed on disk since the last event.
+	UPROPERTY(BlueprintAssignable, Category = "AssetVault|Vault")
+	FOnVaultEntriesChanged OnEntriesChanged;
+
+private:
+	void HandleDirectoryChanged(const TArray<FFileChangeData>& FileChanges);
+	bool Tick(float DeltaTime);
+	void ApplyPendingChanges();
+
+	void ApplyToSearchIndex(const FAssetVaultChangeSet& Changes);
+
+	TSharedPtr<FAssetVaultCatalog> Catalog;
+	FAssetVaultSearchIndex SearchIndex;
+	FAssetVaultEntryViews EntryViews;
+	TUniquePtr<FAssetVaultPreviewCache> PreviewCache;
+
+	FString WatchedDirectory;
+	FDelegateHandle WatcherHandle;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	// Directories relative to the vault root that changed since the last refresh.
+	TSet<FString> PendingDirs;
+	bool bFullRefreshPending = false;
+	double LastChangeTime = 0.0;
+};
@@ -15,6 +15,16 @@ enum class EAssetType : uint8
 	Other         UMETA(DisplayName = "Other")
 };
 
+UENUM(BlueprintType)
+enum class EAssetVaultSortKey : uint8
+{
+	Name,
+	AssetType		UMETA(DisplayName = "Type"),
+	EngineVersion	UMETA(DisplayName = "Engine Version"),
+	Version,
+	Date
+};
+
 USTRUCT(BlueprintType)
 struct FAssetMainInfo
 {
@@ -82,6 +92,7 @@ struct FAssetAdditionalInfo
 	GENERATED_BODY()
 
 
+	// Names of the assets that have an image in the export's AssetVault.avpreview.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Additional Info")
 	TArray<FString> PreviewImagePaths;
 
@@ -111,5 +122,86 @@ struct FAssetExportOptions
 	FAssetAdditionalInfo AdditionalInfo;
 };
 
+USTRUCT(BlueprintType)
+struct FAssetVaultChangeSet
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Vault")
+	TArray<FAssetExportOptions> Added;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Vault")
+	TArray<FAssetExportOptions> Modified;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Vault")
+	TArray<FAssetExportOptions> Removed;
+
+	// Metadata file of each entry, relative to the vault root, in the same order as the arrays above.
+	UPROPERTY(BlueprintReadOnly, Category = "Vault")
+	TArray<FString> AddedFiles;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Vault")
+	TArray<FString> ModifiedFiles;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Vault")
+	TArray<FString> RemovedFiles;
+
+	bool IsEmpty() const { return Added.IsEmpty() && Modified.IsEmpty() && Removed.IsEmpty(); }
+};
+
+UENUM(BlueprintType)
+enum class EAssetVaultExportPhase : uint8
+{
+	ResolvingDependencies,
+	Copying,
+	Finalizing
+};
+
+USTRUCT(BlueprintType)
+struct FAssetVaultExportStatus
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Vault")
+	EAssetVaultExportPhase Phase = EAssetVaultExportPhase::ResolvingDependencies;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Vault")
+	int32 PackagesResolved = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Vault")
+	int32 PackagesCopied = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Vault")
+	int32 PackagesTotal = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Vault")
+	int64 BytesCopied = 0;
+
+	// Estimated time left while copying, -1 when unknown.
+	UPROPERTY(BlueprintReadOnly, Category = "Vault")
+	float RemainingSeconds = -1.0f;
+};
 
+UENUM(BlueprintType)
+enum class EAssetVaultImportFileState : uint8
+{
+	New,
+	Identical,
+	Modified
+};
+
+// Package files of an export, relative to the export folder, grouped by how they compare with the project.
+USTRUCT(BlueprintType)
+struct FAssetVaultImportAnalysis
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Vault")
+	TArray<FString> NewFiles;
 
+	UPROPERTY(BlueprintReadOnly, Category = "Vault")
+	TArray<FString> IdenticalFiles;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Vault")
+	TArray<FString> ModifiedFiles;
+};
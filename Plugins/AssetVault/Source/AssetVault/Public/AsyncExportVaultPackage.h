@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetVaultTypes.h"
+#include "FAssetPackageManager.h"
+#include "Containers/Ticker.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+
+#include "AsyncExportVaultPackage.generated.h"
+
+class SNotificationItem;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnVaultExportProgress, const FAssetVaultExportStatus&, Status);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnVaultExportFinished, bool, bSuccess, const FString&, Message);
+
+// Background version of UAssetPackageManager::ExportAssetToPackage and ExportMultipleAssetsToPackage.
+// The game thread only reads the assets' package names, dependency resolution and file I/O run on a
+// worker. Progress is shown in a notification with a cancel button, a cancelled export removes its output.
+UCLASS()
+class ASSETVAULT_API UAsyncExportVaultPackage : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+
+	UFUNCTION(BlueprintCallable, Category = "AssetVault|Export", meta = (BlueprintInternalUseOnly = "true"))
+	static UAsyncExportVaultPackage* ExportAssetsToPackageAsync(const TArray<UObject*>& Assets, const FString& ExportDirectory, const FAssetExportOptions& ExportOptions);
+
+	// Broadcast a few times per second while the export runs.
+	UPROPERTY(BlueprintAssignable)
+	FOnVaultExportProgress OnProgress;
+
+	UPROPERTY(BlueprintAssignable)
+	FOnVaultExportFinished OnCompleted;
+
+	// Stops the export after the files in flight, OnCompleted follows with bSuccess = false.
+	UFUNCTION(BlueprintCallable, Category = "AssetVault|Export")
+	void Cancel();
+
+	virtual void Activate() override;
+
+private:
+	bool Tick(float DeltaTime);
+	FAssetVaultExportStatus GetStatus();
+	void Finish(bool bSuccess, const FString& Message);
+
+	TArray<FName> RootPackages;
+	FString ExportDirectory;
+	FAssetExportOptions ExportOptions;
+	FString MetadataBaseName;
+
+	TSharedRef<FAssetVaultExportProgress> Progress = MakeShared<FAssetVaultExportProgress>();
+	TSharedPtr<SNotificationItem> Notification;
+	FTSTicker::FDelegateHandle TickerHandle;
+	double CopyStartTime = 0.0;
+};
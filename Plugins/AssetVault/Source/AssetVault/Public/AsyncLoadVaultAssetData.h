@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetVaultTypes.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+
+#include <atomic>
+
+#include "AsyncLoadVaultAssetData.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnVaultAssetDataBatch, const TArray<FAssetExportOptions>&, Entries);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnVaultAssetDataReset);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnVaultAssetDataLoaded, int32, TotalEntries);
+
+// Background version of UAssetPackageManager::LoadAllAssetDataFromDirectory.
+// Cached catalog entries are delivered right away, freshly parsed entries follow in batches.
+UCLASS()
+class ASSETVAULT_API UAsyncLoadVaultAssetData : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+
+	UFUNCTION(BlueprintCallable, Category = "AssetVault|Export", meta = (BlueprintInternalUseOnly = "true"))
+	static UAsyncLoadVaultAssetData* LoadAllAssetDataFromDirectoryAsync(const FString& DirectoryPath, int32 BatchSize = 256);
+
+	// Entries to append to the list.
+	UPROPERTY(BlueprintAssignable)
+	FOnVaultAssetDataBatch OnBatch;
+
+	// The cached entries delivered so far are stale, clear the list. Fresh batches follow.
+	UPROPERTY(BlueprintAssignable)
+	FOnVaultAssetDataReset OnReset;
+
+	UPROPERTY(BlueprintAssignable)
+	FOnVaultAssetDataLoaded OnCompleted;
+
+	// Stops the background scan. No further events are broadcast.
+	UFUNCTION(BlueprintCallable, Category = "AssetVault|Export")
+	void Cancel();
+
+	virtual void Activate() override;
+
+private:
+	void RunOnGameThread(TUniqueFunction<void(UAsyncLoadVaultAssetData&)> Function);
+
+	FString DirectoryPath;
+	int32 BatchSize = 256;
+
+	TSharedRef<std::atomic<bool>> CancelFlag = MakeShared<std::atomic<bool>>(false);
+};
@@ -2,9 +2,37 @@
 
 #include "CoreMinimal.h"
 #include "AssetVaultTypes.h" // Подключаем файл с вашими структурами
+#include "AssetVaultCopyEngine.h"
 #include "UObject/NoExportTypes.h"
 #include "FAssetPackageManager.generated.h"
 
+class SNotificationItem;
+
+// Live state of an export, shared between the thread running it and the game thread watching it.
+struct FAssetVaultExportProgress
+{
+	FAssetVaultCopyProgress Copy;
+	std::atomic<EAssetVaultExportPhase> Phase{ EAssetVaultExportPhase::ResolvingDependencies };
+	std::atomic<int32> PackagesResolved{ 0 };
+
+	void Cancel() { Copy.bCancel = true; }
+	bool IsCancelled() const { return Copy.bCancel.load(); }
+};
+
+// What an import did, counted by the import itself from its one classification pass.
+struct FAssetVaultImportResult
+{
+	int32 NumNew = 0;
+	int32 NumIdentical = 0;
+	int32 NumModified = 0;
+
+	int32 NumCopied = 0;
+	int32 NumReplaced = 0;
+	int32 NumSkippedExisting = 0;
+	int32 NumFailed = 0;
+	int64 BytesCopied = 0;
+};
+
 UCLASS()
 class ASSETVAULT_API UAssetPackageManager : public UObject
 {
@@ -25,6 +53,7 @@ public:
 	static TArray<FAssetExportOptions> LoadAllAssetDataFromDirectory(const FString& DirectoryPath);
 	
 	
+	// For an open vault, UAssetVaultSubsystem::GetEntryPage filters and sorts without copying the whole list.
 	UFUNCTION(BlueprintCallable, Category = "Asset Manager")
 	static TArray<FAssetExportOptions> FilterAndSortAssets(const TArray<FAssetExportOptions>& Assets,EAssetType FilterType);
 
@@ -34,6 +63,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Asset Vault")
 	static void ShowEditorNotification(const FString& Message, bool bSuccess);
 
+	// Same toast with a throbber and a cancel button, stays up until CompleteEditorNotification.
+	static TSharedPtr<SNotificationItem> ShowEditorProgressNotification(const FString& Message, FSimpleDelegate OnCancel);
+	static void CompleteEditorNotification(const TSharedPtr<SNotificationItem>& Item, const FString& Message, bool bSuccess);
+
 	
 	UFUNCTION(BlueprintCallable, Category = "Asset Management")
 	static void OpenFolderInExplorer(const FString& BaseDirectory, FString RelativeExportPath);
@@ -41,7 +74,16 @@ public:
 	
 	UFUNCTION(BlueprintCallable, Category = "Vault|Import")
 	static bool ImportAssetFolderToProject(const FString& DefaultDirectory,const FString& RelativeExportPath,const FString& TargetSubfolder,bool bForceOverwrite);
+
+	// ImportAssetFolderToProject with per-file counts, for callers that report on the import.
+	static bool ImportPackagesFromFolder(const FString& DefaultDirectory, const FString& RelativeExportPath, const FString& TargetSubfolder,
+		bool bForceOverwrite, FAssetVaultImportResult& OutResult);
 	
+	// Sorts the export's package files into new, identical and modified relative to the target folder.
+	UFUNCTION(BlueprintCallable, Category = "Vault|Import")
+	static FAssetVaultImportAnalysis AnalyzeImportConflicts(const FString& DefaultDirectory, const FString& RelativeExportPath, const FString& TargetSubfolder);
+
+	// Lists the packages the import would overwrite with different content.
 	UFUNCTION(BlueprintCallable, Category = "Vault|Import")
 	static bool DoesAssetAlreadyExist(const FString& DefaultDirectory,const FString& RelativeExportPath,const FString& TargetSubfolder,UPARAM(ref) TArray<FString>& OutConflictingAssets);
 
@@ -51,6 +93,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Asset Export")
 	static bool ExportMultipleAssetsToPackage(const TArray<UObject*>& Assets,const FString& ExportDirectory,const FAssetExportOptions& ExportOptions);
 
+	// Everything of an export past reading the assets' package names: dependency resolution, file copies and
+	// the metadata file. Does not touch UObjects or Slate, so it can run on a worker thread.
+	// OutMessage is set for failures worth showing to the user. A cancelled export removes what it wrote.
+	static bool ExportPackagesToFolder(const TArray<FName>& RootPackages, const FString& ExportDirectory, FAssetExportOptions ExportOptions,
+		const FString& MetadataBaseName, FString& OutMessage, FAssetVaultExportProgress* Progress = nullptr);
+
 	UFUNCTION(BlueprintPure, Category = "Vault")
 	static FString GetAssetTypeNameByIndex(int32 Index);
 
@@ -62,5 +110,5 @@ public:
 	
 	
 private:
-	static bool CopyAssetWithDependencies(UObject* Asset, const FString& TargetDirectory);
+	static bool CopyPackages(const TSet<FName>& Packages, const FString& TargetDirectory, const FAssetVaultCopyEngine& CopyEngine, FAssetVaultCopyReport& OutReport);
 };